@@ -1,13 +1,20 @@
 // NOTE: This file is autogenerated. Do not edit manually.
 #pragma once
 #include <libdragon.h>
+#include <lib/perfectHash.h>
 
 namespace P64::Assets
 {
-  consteval uint32_t getAssetIndex(std::string_view path)
+  namespace Table
   {
     {{ASSET_MAP}}
-    assertf(false, "Asset unknown!");
+  }
+
+  consteval uint32_t getAssetIndex(std::string_view path)
+  {
+    auto slot = PerfectHash::find(path, Table::ASSET_SEEDS, Table::ASSET_KEYS);
+    if(slot == PerfectHash::NOT_FOUND)assertf(false, "Asset unknown!");
+    return Table::ASSET_VALUES[slot];
   }
 }
 
@@ -2,13 +2,20 @@
 #pragma once
 #include <libdragon.h>
 #include <string_view>
+#include <lib/perfectHash.h>
 
 namespace P64::SceneManager
 {
-  consteval uint16_t getSceneIdx(std::string_view path)
+  namespace Table
   {
     {{SCENE_MAP}}
-    assertf(false, "Scene unknown!");
+  }
+
+  consteval uint16_t getSceneIdx(std::string_view path)
+  {
+    auto slot = PerfectHash::find(path, Table::SCENE_SEEDS, Table::SCENE_KEYS);
+    if(slot == PerfectHash::NOT_FOUND)assertf(false, "Scene unknown!");
+    return Table::SCENE_VALUES[slot];
   }
 
   extern const char* SCENE_NAMES[{{SCENE_COUNT}}];
@@ -0,0 +1,96 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace P64::Coll
+{
+  /**
+   * Sweep-and-prune broadphase for dynamic colliders.
+   * Proxies are kept sorted along the X-axis across frames. Since things only move a little
+   * each frame, re-sorting is a nearly linear insertion-sort pass.
+   * Only depends on the standard library, so it can be used and tested outside of libdragon.
+   */
+  class Broadphase
+  {
+    public:
+      struct Bounds {
+        float min[3]{};
+        float max[3]{};
+      };
+
+      // potentially colliding proxies, with 'a < b'
+      struct Pair {
+        uint16_t a{};
+        uint16_t b{};
+      };
+
+    private:
+      std::vector<Bounds> bounds{};
+      std::vector<uint16_t> order{}; // proxy indices, sorted by 'min[0]'
+      std::vector<Pair> pairs{};
+      float maxSizeX{0.0f}; // largest extend on the X-axis, limits how far back a query has to look
+      bool isSorted{true};
+
+      void sort();
+
+    public:
+      /**
+       * Adds a new proxy at the end, the returned index is the same as the previous count.
+       * Bounds must be set before the next 'update'.
+       */
+      uint32_t add();
+
+      /**
+       * Removes a proxy, all proxies after it move down by one index.
+       * This matches erasing the same index in the caller's own list.
+       */
+      void remove(uint32_t idx);
+
+      void setBounds(uint32_t idx, const Bounds &newBounds) {
+        bounds[idx] = newBounds;
+        isSorted = false;
+      }
+
+      [[nodiscard]] uint32_t getCount() const {
+        return bounds.size();
+      }
+
+      /**
+       * Re-sorts all proxies and collects pairs with overlapping bounds.
+       * Pairs are ordered by 'a' and then 'b', so the result does not depend on the sort order.
+       */
+      const std::vector<Pair> &update();
+
+      /**
+       * Calls 'callback' with the index of each proxy overlapping the given bounds.
+       * Uses the sorted order to only look at proxies close to the area on the X-axis.
+       * Re-sorts first if any bounds changed since the last 'update'.
+       */
+      template<typename F>
+      void query(const Bounds &area, F &&callback)
+      {
+        if(!isSorted)sort();
+
+        // anything starting before this can't reach the area
+        float startX = area.min[0] - maxSizeX;
+        auto it = std::lower_bound(order.begin(), order.end(), startX, [this](uint16_t idx, float x) {
+          return bounds[idx].min[0] < x;
+        });
+
+        for(; it != order.end(); ++it)
+        {
+          const auto &b = bounds[*it];
+          if(b.min[0] > area.max[0])break;
+          if(b.max[0] < area.min[0])continue;
+          if(b.max[1] < area.min[1] || area.max[1] < b.min[1])continue;
+          if(b.max[2] < area.min[2] || area.max[2] < b.min[2])continue;
+          callback(*it);
+        }
+      }
+  };
+}
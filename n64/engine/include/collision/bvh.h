@@ -8,33 +8,95 @@
 
 namespace P64::Coll
 {
-  constexpr int MAX_RESULT_COUNT = 32;
-
-  struct BVHResult {
-    int16_t triIndex[MAX_RESULT_COUNT]{};
-    int16_t count{};
-
-    void reset() { count = 0; }
-  };
-
   struct BVHNode {
-    AABB aabb{};
-    uint16_t value{};
+    // bounds relative to the parent, in 1/256th of its size (max. is measured down from the parent's max.)
+    uint8_t min[3]{};
+    uint8_t max[3]{};
+    uint16_t triCount{}; // 0 for inner nodes
+    uint16_t index{}; // first triangle for leaf-nodes, otherwise the first child (the second one follows)
+
+    /**
+     * Returns the bounds of this node, given the ones of its parent.
+     * This rounds outwards, so the result always covers the original bounds.
+     */
+    [[nodiscard]] AABB decode(const AABB &parent) const {
+      AABB res;
+      for(int i=0; i<3; ++i) {
+        int size = parent.max.v[i] - parent.min.v[i];
+        res.min.v[i] = (int16_t)(parent.min.v[i] + ((min[i] * size) >> 8));
+        res.max.v[i] = (int16_t)(parent.max.v[i] - ((max[i] * size) >> 8));
+      }
+      return res;
+    }
   };
-  static_assert(sizeof(BVHNode) == (7 * sizeof(int16_t)));
+  static_assert(sizeof(BVHNode) == (5 * sizeof(int16_t)));
 
   struct BVH {
+    // max. depth of the tree, the builder creates far shallower trees than this
+    constexpr static int STACK_SIZE = 64;
+
+    AABB bounds; // bounds of the entire tree, nodes are relative to this
     uint16_t nodeCount;
-    uint16_t dataCount;
     BVHNode nodes[];
-    // uint16_t data[];
 
-    void vsAABB(const AABB &aabb, BVHResult &res) const;
+    /**
+     * Iterates over the tree, calling 'onTriangle(triIndex)' for every triangle
+     * in all leaf-nodes that pass 'testNode(aabb)'.
+     * Triangles are passed as they are found, so there is no limit on the amount of results.
+     */
+    template<typename FNode, typename FTri>
+    void traverse(FNode &&testNode, FTri &&onTriangle) const
+    {
+      if(nodeCount == 0)return;
+
+      // Explicit stack, bounds of a node are decoded when it gets pushed since that needs the parent.
+      // Tests happen when popping instead, so changes made in 'onTriangle' still affect the remaining nodes.
+      struct StackEntry {
+        const BVHNode *node;
+        AABB aabb;
+      };
+      StackEntry stack[STACK_SIZE];
+      int stackSize = 0;
+      stack[stackSize++] = {nodes, nodes[0].decode(bounds)};
 
-    inline void vsBCS(const BCS &bcs, BVHResult &res) const {
-      vsAABB((bcs).toAABB(), res);
+      while(stackSize > 0)
+      {
+        auto entry = stack[--stackSize];
+        if(!testNode(entry.aabb))continue;
+
+        const BVHNode *node = entry.node;
+        if(node->triCount == 0) {
+          assertf(stackSize + 2 <= STACK_SIZE, "BVH too deep");
+          const BVHNode *child = &nodes[node->index];
+          stack[stackSize++] = {&child[1], child[1].decode(entry.aabb)};
+          stack[stackSize++] = {&child[0], child[0].decode(entry.aabb)};
+          continue;
+        }
+
+        uint32_t triEnd = node->index + node->triCount;
+        for(uint32_t t = node->index; t < triEnd; ++t) {
+          onTriangle(t);
+        }
+      }
+    }
+
+    template<typename FTri>
+    void vsAABB(const AABB &aabb, FTri &&onTriangle) const {
+      traverse([&aabb](const AABB &nodeAABB) { return nodeAABB.vsAABB(aabb); }, onTriangle);
     }
 
-    void raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, BVHResult &res) const;
+    template<typename FTri>
+    void vsBCS(const BCS &bcs, FTri &&onTriangle) const {
+      vsAABB(bcs.toAABB(), onTriangle);
+    }
+
+    /**
+     * Visits all triangles in nodes the ray enters before 'maxDist'.
+     * 'maxDist' is re-checked for every node, so lowering it in the callback prunes the rest of the search.
+     */
+    template<typename FTri>
+    void raycast(const Ray &ray, const float &maxDist, FTri &&onTriangle) const {
+      traverse([&ray, &maxDist](const AABB &nodeAABB) { return nodeAABB.vsRay(ray, maxDist); }, onTriangle);
+    }
   };
-}
\ No newline at end of file
+}
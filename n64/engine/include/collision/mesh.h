@@ -18,20 +18,40 @@ namespace P64::Coll
 
   struct Mesh
   {
+    constexpr static uint32_t VERSION = 0x434C0002; // "CL" + layout version, see 'Collision::writeMesh' in the editor
+    constexpr static uint32_t FLAG_EDGE_NORMALS = 1 << 0;
+    constexpr static float SWEEP_SKIN = 0.05f; // max. gap left between a shape and the triangle it was swept against
+
     // NOTE: don't place any extra members here!
     // mirrors the collion data in the t3dm extension
+    uint32_t version{};
     uint32_t triCount{};
     uint32_t vertCount{};
-    float collScale{};
-    fm_vec3_t *verts{};
+    float collScale{}; // scale of the quantized vertices
+    uint32_t flags{};
+    IVec3 *verts{};
     IVec3 *normals{};
+    IVec3 *edgeNormals{}; // optional, 3 per triangle (see 'Triangle::edgeNormals')
     BVH* bvh{};
-    // data follows here: indices, normals, verts, BVH
+    // data follows here: indices, normals, edge-normals, verts, BVH
+    // triangles are sorted by the BVH, so triangles of a node are next to each other
     int16_t indices[];
 
+    [[nodiscard]] fm_vec3_t getVert(uint32_t idx) const {
+      const auto &v = verts[idx];
+      return {(float)v.v[0] * collScale, (float)v.v[1] * collScale, (float)v.v[2] * collScale};
+    }
+
     [[nodiscard]] CollInfo vsSphere(const BCS &sphere, const Triangle& triangle) const;
     [[nodiscard]] CollInfo vsBox(const BCS &box, const Triangle& triangle) const;
-    [[nodiscard]] RaycastRes vsRay(const fm_vec3_t &pos, const fm_vec3_t &dir, const Triangle& triangle) const;
+    [[nodiscard]] RaycastRes vsRay(const Ray &ray, const Triangle& triangle) const;
+
+    /**
+     * Returns the time of impact (0-1) when moving a shape by 'motion', or a value above 1 if there is none.
+     * Contacts that already exist at the start are ignored, the regular tests handle those.
+     * Spheres stop up to 'SWEEP_SKIN' before the surface, boxes already overlap it.
+     */
+    [[nodiscard]] float sweep(const BCS &bcs, const fm_vec3_t &motion, const Triangle& triangle) const;
 
     static Mesh* load(void* rawData);
   };
@@ -43,8 +63,29 @@ namespace P64::Coll
     fm_vec3_t invScale{};
     fm_quat_t invRot{};
 
+    // world-space bounds, only re-calculated if the transform changed
+    fm_vec3_t aabbMin{};
+    fm_vec3_t aabbMax{};
+
+    // transform the cached values above were calculated with
+    fm_vec3_t lastPos{};
+    fm_quat_t lastRot{};
+    fm_vec3_t lastScale{};
+    bool isCacheValid{false};
+    bool hasListener{false}; // object has components with 'onColl', set by the scene
+
     fm_vec3_t intoLocalSpace(const fm_vec3_t &p) const;
     fm_vec3_t outOfLocalSpace(const fm_vec3_t &p) const;
-    void update();
+
+    /**
+     * Updates the cached transform and bounds.
+     * @return true if the transform changed since the last call
+     */
+    bool update();
+
+    [[nodiscard]] bool vsAABB(const fm_vec3_t &min, const fm_vec3_t &max) const {
+      return aabbMax.x >= min.x && aabbMax.y >= min.y && aabbMax.z >= min.z
+          && aabbMin.x <= max.x && aabbMin.y <= max.y && aabbMin.z <= max.z;
+    }
   };
 }
@@ -4,9 +4,10 @@
 */
 #pragma once
 
+#include "broadphase.h"
 #include "mesh.h"
 #include "shapes.h"
-#include <set>
+#include <algorithm>
 #include <vector>
 
 namespace P64::Coll
@@ -15,41 +16,174 @@ namespace P64::Coll
     private:
       constexpr static uint32_t VOID_SPHERE_COUNT = 2;
 
-      std::set<MeshInstance*> meshes{};
+      /**
+       * Per-body state kept across frames.
+       * Triangles found near a body are cached together with the volume they were searched in,
+       * as long as the body stays inside of it (and no mesh there moved), the BVH query is skipped.
+       */
+      struct BodyState
+      {
+        std::vector<MeshInstance*> meshes{};
+        std::vector<uint16_t> tris{}; // triangles of all cached meshes
+        std::vector<uint32_t> trisEnd{}; // end index into 'tris' per mesh
+        fm_vec3_t cacheMin{};
+        fm_vec3_t cacheMax{};
+        uint32_t cacheGeneration{0}; // only valid if equal to 'meshGeneration'
+
+        // sleeping bodies skip all mesh collision until they get moved or touched
+        fm_vec3_t lastCenter{};
+        MeshInstance *sleepMesh{}; // mesh it rests on, to keep reporting the contact
+        uint8_t sleepHitTriTypes{0};
+        uint8_t restFrames{0};
+        bool isSleeping{false};
+        bool hasListener{false}; // object has components with 'onColl', otherwise events are skipped
+      };
+
+      std::vector<MeshInstance*> meshes{};
+      std::vector<MeshInstance*> meshesMoved{}; // meshes with a new transform this frame
+      uint32_t meshGeneration{1}; // incremented when meshes get (un)registered
       std::vector<BCS*> collBCS{};
+      std::vector<BodyState> bodyStates{}; // shares the index with 'collBCS'
+      Broadphase broadphase{}; // proxies share the index with 'collBCS'
+
+      CollInfo vsBCS(BCS &bcs, BodyState &state, const fm_vec3_t &velocity, float deltaTime);
+      [[nodiscard]] bool isCacheValid(const BodyState &state, const fm_vec3_t &min, const fm_vec3_t &max) const;
+      void updateCache(BodyState &state, const fm_vec3_t &min, const fm_vec3_t &max);
+      bool updateSleep(BCS &bcs, BodyState &state);
 
-      CollInfo vsBCS(BCS &bcs, const fm_vec3_t &velocity, float deltaTime);
+      // bodies that can move, and currently do so
+      static bool isActive(const BCS &bcs, const BodyState &state) {
+        return bcs.isSolid() && !bcs.isFixed() && !state.isSleeping;
+      }
+
+      // checked once on registration, the components of an object can't change
+      static bool hasListener(const Object *obj);
+
+      static void wakeUp(BodyState &state) {
+        state.isSleeping = false;
+        state.restFrames = 0;
+      }
+
+      /**
+       * Tests a ray against all meshes and boxes, keeping the closest hit in 'res'.
+       * Only hits closer than 'res.dist' are considered, so it must be set to the max. distance.
+       * With 'anyHit' set, the search stops at the first hit instead.
+       */
+      void raycastAll(const Ray &ray, RaycastRes &res, bool anyHit);
+      void raycastMesh(const MeshInstance &meshInst, const Ray &ray, RaycastRes &res, bool anyHit);
+      void raycastMeshLocal(const MeshInstance &meshInst, const Ray &rayLocal, RaycastRes &res, bool anyHit);
+      void raycastBCS(const Ray &ray, RaycastRes &res);
+
+      template<typename F>
+      uint32_t overlap(const Broadphase::Bounds &area, OverlapRes *res, uint32_t maxRes, uint8_t mask, F &&isHit);
 
     public:
       uint64_t ticks{0};
       uint64_t ticksBVH{0};
       uint64_t raycastCount{0};
+      uint32_t cacheHits{0};
+      uint32_t cacheMisses{0};
 
       void registerMesh(MeshInstance *mesh) {
+        mesh->isCacheValid = false;
+        mesh->hasListener = hasListener(mesh->object);
         mesh->update();
-        meshes.insert(mesh);
+        if(std::find(meshes.begin(), meshes.end(), mesh) == meshes.end()) {
+          meshes.push_back(mesh);
+          ++meshGeneration;
+        }
       }
 
       void unregisterMesh(MeshInstance *mesh) {
-        meshes.erase(mesh);
+        std::erase(meshes, mesh);
+        ++meshGeneration;
       }
 
       void registerBCS(BCS *bcs) {
         collBCS.push_back(bcs);
+        bodyStates.push_back({
+          .lastCenter = bcs->center,
+          .hasListener = hasListener(bcs->obj),
+        });
+        broadphase.add();
       }
 
       void unregisterBCS(BCS *bcs) {
-        for(auto it = collBCS.begin(); it != collBCS.end(); ++it) {
-          if(*it == bcs)return (void)collBCS.erase(it);
+        for(uint32_t i=0; i<collBCS.size(); ++i) {
+          if(collBCS[i] == bcs) {
+            collBCS.erase(collBCS.begin() + i);
+            bodyStates.erase(bodyStates.begin() + i);
+            broadphase.remove(i);
+            return;
+          }
         }
       }
 
-      RaycastRes raycast(const fm_vec3_t &pos, const fm_vec3_t &dir);
+      /**
+       * Returns the closest hit of a ray with any mesh or box collider.
+       * Distances are in multiples of 'dir', so use a normalized direction to get world units.
+       */
+      RaycastRes raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist = INFINITY);
+
+      /**
+       * Checks if anything is hit within 'maxDist' (e.g. for line-of-sight checks).
+       * Stops at the first hit, which is cheaper than searching for the closest one.
+       */
+      bool raycastAny(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist = INFINITY);
+
+      /**
+       * Casts multiple rays at once, each getting the closest hit like 'raycast'.
+       * The transform into the local space of each mesh is only prepared once for all rays,
+       * which is faster than separate calls.
+       * @param rays rays to cast (see 'Ray::create')
+       * @param maxDist max. distance for each ray
+       * @param res results, one per ray
+       * @param count number of rays
+       */
+      void raycastBatch(const Ray *rays, const float *maxDist, RaycastRes *res, uint32_t count);
+
+      /**
+       * Collects all colliders overlapping a sphere, e.g. to find enemies in range.
+       * Only colliders with a matching bit in 'maskWrite' are reported.
+       * Uses the bounds from the last 'update', so colliders added or moved since then may be missed.
+       * @param res output, filled with up to 'maxRes' entries
+       * @return number of results
+       */
+      uint32_t overlapSphere(const fm_vec3_t &center, float radius, OverlapRes *res, uint32_t maxRes, uint8_t mask = 0xFF);
+
+      /**
+       * Collects all colliders overlapping an axis-aligned box, see 'overlapSphere'.
+       */
+      uint32_t overlapBox(const fm_vec3_t &center, const fm_vec3_t &halfExtend, OverlapRes *res, uint32_t maxRes, uint8_t mask = 0xFF);
+
+      /**
+       * Collects all colliders touched by a ray within 'maxDist' (in any order), see 'overlapSphere'.
+       * Unlike 'raycast', this ignores meshes and includes colliders the ray starts in.
+       * Infinite rays have to check every collider, so prefer a limited distance.
+       */
+      uint32_t overlapRay(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist, OverlapRes *res, uint32_t maxRes, uint8_t mask = 0xFF);
 
       [[nodiscard]] const std::vector<BCS*> &getSpheres() const {
         return collBCS;
       }
 
+      /**
+       * Wakes up a sleeping body, e.g. after changing its velocity from outside.
+       * Note that moving it or changing its velocity is detected automatically too.
+       */
+      void wakeUp(const BCS *bcs) {
+        for(uint32_t i=0; i<collBCS.size(); ++i) {
+          if(collBCS[i] == bcs)wakeUp(bodyStates[i]);
+        }
+      }
+
+      [[nodiscard]] bool isSleeping(const BCS *bcs) const {
+        for(uint32_t i=0; i<collBCS.size(); ++i) {
+          if(collBCS[i] == bcs)return bodyStates[i].isSleeping;
+        }
+        return false;
+      }
+
       void update(float deltaTime);
 
       void debugDraw(bool showMesh, bool showSpheres);
@@ -22,13 +22,32 @@ namespace P64::Coll
     int16_t v[3]{};
   };
 
+  /**
+   * Ray with pre-calculated data for slab tests.
+   * Distances along the ray are in multiples of 'dir', so a normalized direction gives world units.
+   */
+  struct Ray
+  {
+    fm_vec3_t pos{};
+    fm_vec3_t dir{};
+    fm_vec3_t invDir{};
+
+    static Ray create(const fm_vec3_t &pos, const fm_vec3_t &dir);
+
+    /**
+     * Slab test against a box, only succeeds if the box is entered before 'maxDist'.
+     * @param tNear distance where the ray enters the box (negative if it starts inside)
+     */
+    bool vsBox(const fm_vec3_t &min, const fm_vec3_t &max, float maxDist, float &tNear) const;
+  };
+
   struct AABB
   {
     IVec3 min{};
     IVec3 max{};
 
     bool vsAABB(const AABB &other) const;
-    bool vsRay(const fm_vec3_t &pos, const fm_vec3_t &dir) const;
+    bool vsRay(const Ray &ray, float maxDist) const;
     bool vsPoint(const IVec3 &pos) const;
   };
   static_assert(sizeof(AABB) == (6 * sizeof(int16_t)));
@@ -66,6 +85,12 @@ namespace P64::Coll
       return flags & BCSFlags::FIXED_XYZ;
     }
 
+    // extend of the bounding-box, spheres only use the radius in 'halfExtend'
+    [[nodiscard]] fm_vec3_t getBoundsExtend() const {
+      if(flags & BCSFlags::SHAPE_BOX)return halfExtend;
+      return {getRadius(), getRadius(), getRadius()};
+    }
+
     [[nodiscard]] fm_vec3_t getMinAABB() const {
       return center - halfExtend;
     }
@@ -102,17 +127,25 @@ namespace P64::Coll
     fm_vec3_t hitPos{};
     fm_vec3_t normal{};
     uint32_t flags{};
+    float dist{}; // distance along the ray, in multiples of its direction
 
     [[nodiscard]] bool hasResult() const {
       return flags != 0;
     }
   };
 
+  struct OverlapRes {
+    BCS *bcs{};
+    uint16_t objectId{}; // object the collider belongs to
+  };
+
   struct Triangle
   {
     fm_vec3_t normal{};
-    fm_vec3_t* v[3]{};
+    fm_vec3_t v[3]{};
     AABB aabb{};
+    // optional, inward-facing normals of the planes through each edge (v0->v1, v1->v2, v2->v0)
+    const IVec3* edgeNormals{};
   };
 
   struct Triangle2D {
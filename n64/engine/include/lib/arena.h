@@ -0,0 +1,88 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+#include <vector>
+#include "lib/types.h"
+
+namespace P64::Mem
+{
+  /**
+   * Allocator for data that lives as long as a scene (e.g. objects and their components).
+   * Memory is taken from large chunks, rounded up to a few size classes.
+   * Freed blocks go into a free-list per class, so objects spawned at runtime re-use them.
+   * Nothing is returned to the heap until 'reset', which frees everything at once.
+   * Allocations are 8-byte aligned.
+   */
+  class Arena
+  {
+    public:
+      static constexpr uint32_t HEADER_SIZE = 8; // in front of each allocation, counts towards the size class
+      static constexpr uint32_t CLASS_COUNT = 15;
+
+      // steps of 1.5x/2x, so at most ~1/3 of a block is wasted
+      static constexpr uint32_t CLASS_SIZES[CLASS_COUNT] {
+        32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+      };
+
+      struct Stats
+      {
+        uint32_t chunkCount{0};
+        uint32_t bytesReserved{0}; // taken from the heap, chunks and large blocks
+        uint32_t bytesUsed{0}; // in live allocations (incl. size class rounding)
+        uint32_t bytesUsedPeak{0};
+        uint32_t allocCount{0}; // live allocations
+        uint32_t freeListHits{0}; // allocations served from a free-list
+      };
+
+    private:
+      static constexpr uint32_t CHUNK_SIZE = 16 * 1024;
+      static constexpr uint32_t LARGE_CLASS = CLASS_COUNT; // too big for a class, gets its own block
+
+      struct FreeBlock {
+        FreeBlock *next;
+      };
+
+      FreeBlock* freeLists[CLASS_COUNT]{};
+      std::vector<void*> blocks{}; // chunks and large allocations, all freed on reset
+      uint8_t *chunkPos{nullptr};
+      uint8_t *chunkEnd{nullptr};
+      Stats stats{};
+
+      static uint32_t getSizeClass(uint32_t size) {
+        uint32_t sc = 0;
+        while(sc < CLASS_COUNT && CLASS_SIZES[sc] < size)++sc;
+        return sc;
+      }
+
+      void* allocFromChunk(uint32_t size);
+
+    public:
+      Arena() = default;
+      ~Arena() { reset(); }
+
+      CLASS_NO_COPY_MOVE(Arena);
+
+      /**
+       * Allocates a block of at least the given size, contents are undefined.
+       * @return pointer, 8-byte aligned
+       */
+      void* alloc(uint32_t size);
+
+      /**
+       * Returns a block from 'alloc' to its free-list, large blocks go back to the heap directly.
+       * NOP for nullptr.
+       */
+      void free(void* ptr);
+
+      /**
+       * Frees all memory at once, all pointers from this arena become invalid.
+       * Destructors are not called, this must be done before if needed.
+       */
+      void reset();
+
+      [[nodiscard]] const Stats& getStats() const { return stats; }
+  };
+}
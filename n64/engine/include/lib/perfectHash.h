@@ -0,0 +1,60 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Minimal perfect hash lookup ("hash and displace") for tables generated by the editor.
+ * The editor includes this file too, so both sides are guaranteed to use the same hash.
+ * Has no dependencies on libdragon, and can be used on the host as well.
+ */
+namespace P64::PerfectHash
+{
+  constexpr uint32_t NOT_FOUND = 0xFFFF'FFFF;
+
+  // FNV-1a with a seed, followed by a final mix to spread the lower bits
+  constexpr uint32_t hash(uint32_t seed, std::string_view str) {
+    uint32_t h = 0x811C'9DC5 ^ (seed * 0x9E37'79B9);
+    for(char c : str) {
+      h ^= (uint8_t)c;
+      h *= 0x0100'0193;
+    }
+    h ^= h >> 16;
+    h *= 0x85EB'CA6B;
+    h ^= h >> 13;
+    return h;
+  }
+
+  /**
+   * Resolves a key to its slot.
+   * 'seeds' is indexed by the unseeded hash: positive values are the seed to re-hash with,
+   * negative ones directly encode the slot as '-slot-1'.
+   *
+   * @return slot index, or NOT_FOUND if the key is not in the table
+   */
+  constexpr uint32_t find(
+    std::string_view key,
+    const int32_t *seeds,
+    const std::string_view *keys,
+    uint32_t count
+  ) {
+    if(count == 0)return NOT_FOUND;
+    int32_t seed = seeds[hash(0, key) % count];
+    uint32_t slot = seed < 0 ? (uint32_t)(-seed - 1) : hash(seed, key) % count;
+    return keys[slot] == key ? slot : NOT_FOUND;
+  }
+
+  // same as above, for the generated tables
+  template<size_t N>
+  constexpr uint32_t find(
+    std::string_view key,
+    const std::array<int32_t, N> &seeds,
+    const std::array<std::string_view, N> &keys
+  ) {
+    return find(key, seeds.data(), keys.data(), N);
+  }
+}
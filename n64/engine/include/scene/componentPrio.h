@@ -0,0 +1,18 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+
+/**
+ * Priorities of components that don't use the default (0), lower runs first.
+ * Shared with the editor, which sorts the components of each object by 'prio' when building a scene.
+ */
+namespace P64::CompPrio
+{
+  constexpr int8_t CONSTRAINT = -2; // must come before culling and any drawing
+  // Copies from objects that scripts may have moved in the same frame, running before them would lag a frame behind.
+  constexpr int8_t CONSTRAINT_UPDATE = 1;
+  constexpr int8_t CULLING = -1; // must come before any models
+}
@@ -4,6 +4,7 @@
 */
 #pragma once
 #include <libdragon.h>
+#include <array>
 #include "event.h"
 
 namespace P64::Coll
@@ -30,8 +31,14 @@ namespace P64
     FuncOnEvent onEvent{};
     FuncOnColl onColl{};
     FuncGetAllocSize getAllocSize{};
+    int8_t prio{}; // lower runs first, values are shared with the editor in 'componentPrio.h'
+    int8_t prioUpdate{}; // same as 'prio' unless a component sets 'PRIO_UPDATE', only used for updates
   };
 
   constexpr uint32_t COMP_TABLE_SIZE = 16;
   extern const ComponentDef COMP_TABLE[COMP_TABLE_SIZE];
+
+  // component IDs sorted by 'prioUpdate' / 'prio' (stable), this is the order types get updated / drawn in
+  extern const std::array<uint8_t, COMP_TABLE_SIZE> COMP_ORDER_UPDATE;
+  extern const std::array<uint8_t, COMP_TABLE_SIZE> COMP_ORDER_DRAW;
 }
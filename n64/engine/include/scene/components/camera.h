@@ -37,8 +37,5 @@ namespace P64::Comp
     static void update([[maybe_unused]] Object& obj, [[maybe_unused]] Camera* data, [[maybe_unused]] float deltaTime) {
       obj.pos = data->camera.getPos();
     }
-
-    static void draw([[maybe_unused]] Object& obj, [[maybe_unused]] Camera* data, [[maybe_unused]] float deltaTime) {
-    }
   };
 }
\ No newline at end of file
@@ -5,12 +5,15 @@
 #pragma once
 #include "scene/object.h"
 #include "scene/sceneManager.h"
+#include "scene/componentPrio.h"
 
 namespace P64::Comp
 {
   struct Constraint
   {
     static constexpr uint32_t ID = 7;
+    static constexpr int8_t PRIO = CompPrio::CONSTRAINT;
+    static constexpr int8_t PRIO_UPDATE = CompPrio::CONSTRAINT_UPDATE;
 
     static constexpr uint8_t TYPE_COPY_OBJ = 0;
     static constexpr uint8_t TYPE_COPY_CAM = 2;
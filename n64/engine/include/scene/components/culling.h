@@ -4,12 +4,14 @@
 */
 #pragma once
 #include "scene/object.h"
+#include "scene/componentPrio.h"
 
 namespace P64::Comp
 {
   struct Culling
   {
     static constexpr uint32_t ID = 8;
+    static constexpr int8_t PRIO = CompPrio::CULLING;
 
     fm_vec3_t halfExtend{};
     fm_vec3_t offset{};
@@ -22,9 +24,6 @@ namespace P64::Comp
 
     static void initDelete([[maybe_unused]] Object& obj, Culling* data, void* initData);
 
-    static void update([[maybe_unused]] Object& obj, Culling* data, float deltaTime)
-    {}
-
     static void draw([[maybe_unused]] Object& obj, Culling* data, float deltaTime);
   };
 }
@@ -62,9 +62,5 @@ namespace P64::Comp
         light.addDirLight(data->color, data->dir);
       }
     }
-
-    static void draw([[maybe_unused]] Object& obj, [[maybe_unused]] Light* data, float deltaTime) {
-
-    }
   };
 }
\ No newline at end of file
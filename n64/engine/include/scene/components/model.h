@@ -33,8 +33,6 @@ namespace P64::Comp
 
     static void initDelete([[maybe_unused]] Object& obj, Model* data, void* initData);
 
-    static void update(Object& obj, Model* data, [[maybe_unused]] float deltaTime) {}
-
     static void draw([[maybe_unused]] Object& obj, Model* data, [[maybe_unused]] float deltaTime);
   };
 }
\ No newline at end of file
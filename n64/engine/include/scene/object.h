@@ -37,6 +37,14 @@ namespace P64
       uint16_t group{};
       uint16_t flags{};
       uint16_t compCount{0};
+      // bit per component index that implements 'onColl', the last bit also covers all following ones
+      uint32_t collCompMask{0};
+
+      // hierarchy (parent is 'group'), children are kept in load order and linked by the scene.
+      // the first child points back to the last one in 'prevSibling'
+      Object *firstChild{nullptr};
+      Object *nextSibling{nullptr};
+      Object *prevSibling{nullptr};
 
       // extra data, is overlapping with component data if unused
       fm_quat_t rot{};
@@ -124,7 +132,8 @@ namespace P64
 
       /**
        * Changes the state of the object to be enabled or disabled.
-       * Prefer this over changing flags directly, as components may need to be notified.
+       * Prefer this over changing flags directly, as components may need to be notified,
+       * and the scene needs to know which objects to skip in its update/draw loops.
        * @param isEnabled true to enable, false to disable
        */
       void setEnabled(bool isEnabled);
@@ -136,7 +145,7 @@ namespace P64
       /**
        * Removes the given object from the scene.
        * This is a shortcut for SceneManager::getCurrent().removeObject(obj);
-       * Note: deletion is deferred until the end of the frame.
+       * Note: deletion is deferred until the end of the frame, the object is disabled right away without an EVENT_TYPE_DISABLE.
        */
       void remove();
 
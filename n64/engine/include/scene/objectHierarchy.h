@@ -0,0 +1,85 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+
+/**
+ * Intrusive parent/child lists used by the scene, see 'Object::firstChild'.
+ * Children are kept in load order, the first child points back to the last one in 'prevSibling'.
+ * The parent is looked up via 'getChildList(parentId)', which returns the head of its child list,
+ * or nullptr if the parent doesn't exist (ID 0 is the scene root).
+ * Templates so they can be used without the rest of the scene (e.g. host tests).
+ */
+namespace P64::ObjectHierarchy
+{
+  /**
+   * Appends an object to the child list of its parent ('group').
+   * Objects must be linked in load order, and after their parent.
+   */
+  template<typename T, typename F>
+  void link(T &obj, F &&getChildList)
+  {
+    T** list = getChildList(obj.group);
+    if(!list)return; // parent doesn't exist, the scene file always has parents first
+
+    auto first = *list;
+    obj.nextSibling = nullptr;
+    if(first) {
+      auto last = first->prevSibling;
+      last->nextSibling = &obj;
+      obj.prevSibling = last;
+      first->prevSibling = &obj;
+    } else {
+      obj.prevSibling = &obj;
+      *list = &obj;
+    }
+  }
+
+  /**
+   * Removes an object from the child list of its parent, and detaches its own children.
+   * When deleting multiple objects, all of them must be unlinked before any gets destroyed.
+   */
+  template<typename T, typename F>
+  void unlink(T &obj, F &&getChildList)
+  {
+    // children stay in the scene without a parent
+    for(auto child = obj.firstChild; child;) {
+      auto next = child->nextSibling;
+      child->nextSibling = nullptr;
+      child->prevSibling = nullptr;
+      child = next;
+    }
+    obj.firstChild = nullptr;
+
+    T** list = getChildList(obj.group);
+    if(!list || !obj.prevSibling)return; // never linked, or parent got removed before
+
+    auto first = *list;
+    if(first == &obj) {
+      *list = obj.nextSibling;
+      if(obj.nextSibling)obj.nextSibling->prevSibling = obj.prevSibling;
+    } else {
+      obj.prevSibling->nextSibling = obj.nextSibling;
+      (obj.nextSibling ? obj.nextSibling : first)->prevSibling = obj.prevSibling;
+    }
+    obj.nextSibling = nullptr;
+    obj.prevSibling = nullptr;
+  }
+
+  /**
+   * Calls 'f' for each object in a child list, in load order.
+   * The current object may be unlinked in the callback.
+   */
+  template<typename T, typename F>
+  void iterChildren(T* first, F &&f)
+  {
+    auto child = first;
+    while(child) {
+      auto next = child->nextSibling;
+      f(child);
+      child = next;
+    }
+  }
+}
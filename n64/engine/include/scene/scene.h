@@ -9,10 +9,13 @@
 #include "event.h"
 #include "lighting.h"
 #include "object.h"
+#include "objectHierarchy.h"
 #include "collision/scene.h"
+#include "lib/arena.h"
 #include "lib/types.h"
 #include "renderer/drawLayer.h"
 #include "renderer/pipeline.h"
+#include "scene/componentTable.h"
 #include "scene/camera.h"
 
 namespace P64
@@ -49,7 +52,8 @@ namespace P64
     uint16_t screenHeight{};
     uint32_t flags{};
     color_t clearColor{};
-    uint32_t objectCount{};
+    uint16_t objectCount{};
+    uint16_t maxObjectId{}; // highest ID of all objects in the scene file
 
     Pipeline pipeline{};
     uint8_t frameSkip{};
@@ -70,19 +74,43 @@ namespace P64
 
   class Scene
   {
+    friend class Object; // marks the active state dirty in 'setEnabled'
+
     private:
+      struct CompInstance
+      {
+        Object *obj{};
+        void *data{};
+        bool active{}; // copy of 'obj->isEnabled()', so the loops only touch enabled objects
+      };
+
       std::vector<Camera*> cameras{};
       Camera *camMain{nullptr};
 
       RenderPipeline *renderPipeline{nullptr};
 
+      // objects (incl. component data) live here, freed at once when the scene unloads
+      Mem::Arena arena{};
+
       // @TODO: avoid vector + fragmented alloc
-      std::vector<Object*> objects{};
+      std::vector<Object*> objects{}; // in load/spawn order, deletion keeps the order
+      Object *rootFirstChild{nullptr}; // objects without a parent, same as 'Object::firstChild'
       std::vector<PrefabParams> objectsToAdd{};
 
-      // create a direct lookup table for the first few IDs
-      // most scene probably don't exceed that much anyway
-      std::array<Object*, 128> idLookup{};
+      // ID to object lookup, split into pages which are only allocated once an ID in their range is used.
+      // the page list is sized for all IDs in the scene file, and grows for spawned objects.
+      // a page fills an arena size class exactly (incl. its header), the division by a constant becomes a multiply.
+      static constexpr uint32_t ID_PAGE_ALLOC = Mem::Arena::CLASS_SIZES[6]; // 256 bytes, 62 IDs per page on the N64
+      static constexpr uint32_t ID_PAGE_SIZE = (ID_PAGE_ALLOC - Mem::Arena::HEADER_SIZE) / sizeof(Object*);
+      static_assert(ID_PAGE_SIZE * sizeof(Object*) + Mem::Arena::HEADER_SIZE == ID_PAGE_ALLOC);
+      std::vector<Object**> idPages{};
+
+      // components with an update/draw function, per type (index is the ID) and in object order.
+      // disabled objects stay in here and are skipped via 'CompInstance::active'.
+      // any change to the active state only marks it dirty, the next update/draw step syncs all lists once.
+      std::array<std::vector<CompInstance>, COMP_TABLE_SIZE> compUpdateList{};
+      std::array<std::vector<CompInstance>, COMP_TABLE_SIZE> compDrawList{};
+      bool compActiveDirty{false};
 
       Coll::Scene collScene{};
       std::vector<Object*> pendingObjDelete{};
@@ -99,6 +127,19 @@ namespace P64
       void loadSceneConfig();
       Object* loadObject(uint8_t* &objFile, std::function<void(Object&)> callback = {});
       void loadScene();
+      void setObjectById(uint16_t objId, Object *obj);
+      void addToCompLists(Object &obj);
+      void syncCompActive();
+      void deletePendingObjects();
+      void linkToParent(Object &obj);
+      void unlinkFromParent(Object &obj);
+
+      // head of the child list of an object, ID 0 is the scene root. nullptr if the parent doesn't exist
+      Object** getChildList(uint16_t parentId) {
+        if(parentId == 0)return &rootFirstChild;
+        auto parent = getObjectById(parentId);
+        return parent ? &parent->firstChild : nullptr;
+      }
 
     public:
       uint64_t ticksActorUpdate{0};
@@ -119,6 +160,7 @@ namespace P64
       [[nodiscard]] Camera* getCamera(uint32_t index = 0) { return cameras[index]; }
       [[nodiscard]] Camera& getActiveCamera() { return *camMain; }
       Coll::Scene &getCollision() { return collScene; }
+      [[nodiscard]] const Mem::Arena& getArena() const { return arena; }
 
       void onObjectCollision(const Coll::CollEvent &event);
 
@@ -174,15 +216,27 @@ namespace P64
         const fm_quat_t &rot = {0,0,0,1}
       );
 
+      /**
+       * Removes an object from the scene, this is deferred until the end of the frame.
+       * The object is disabled right away, so none of its components get updated or drawn anymore.
+       * Note: unlike 'Object::setEnabled', this does not send EVENT_TYPE_DISABLE to its components.
+       * The order of all other objects stays the same.
+       * Removing the same object multiple times is safe.
+       */
       void removeObject(Object &obj);
 
-      Object* getObjectById(uint16_t objId) const;
+      Object* getObjectById(uint16_t objId) const {
+        uint32_t page = objId / ID_PAGE_SIZE;
+        if(page >= idPages.size() || !idPages[page])return nullptr;
+        return idPages[page][objId % ID_PAGE_SIZE];
+      }
 
       uint32_t getObjectCount() const { return objects.size(); }
 
       /**
-       * Iterates over all direct children of the given parent object ID.
+       * Iterates over all direct children of the given parent object ID (0 for top-level objects).
        * If you need nested iteration, call this function recursively.
+       * This only visits the children themselves, not all objects in the scene.
        *
        * Note: This function is intentionally a template with a callback.
        * Doing so generates the same ASM as a direct loops with an if+continue,
@@ -194,13 +248,17 @@ namespace P64
        */
       template<typename F>
       void iterObjectChildren(uint16_t parentId, F&& f) const {
-        for (auto o : objects) {
-          if(o->group != parentId)continue;
-          f(o);
-        }
+        auto parent = parentId ? getObjectById(parentId) : nullptr;
+        auto first = parentId ? (parent ? parent->firstChild : nullptr) : rootFirstChild;
+        ObjectHierarchy::iterChildren(first, f);
       }
 
-      void setGroupEnabled(uint16_t groupId, bool enabled) const;
+      /**
+       * Enables/disables a group object, and updates the active state of all objects below it.
+       * @param groupId object id of the group
+       * @param enabled new state
+       */
+      void setGroupEnabled(uint16_t groupId, bool enabled);
 
       [[nodiscard]] Lighting& getLighting() { return lighting; }
 
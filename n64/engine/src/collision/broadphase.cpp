@@ -0,0 +1,80 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "collision/broadphase.h"
+#include <algorithm>
+
+uint32_t P64::Coll::Broadphase::add()
+{
+  uint32_t idx = bounds.size();
+  bounds.push_back({});
+  order.push_back(idx);
+  isSorted = false;
+  return idx;
+}
+
+void P64::Coll::Broadphase::remove(uint32_t idx)
+{
+  bounds.erase(bounds.begin() + idx);
+  std::erase(order, idx);
+  for(auto &o : order) {
+    if(o > idx)--o;
+  }
+  isSorted = false;
+}
+
+void P64::Coll::Broadphase::sort()
+{
+  uint32_t count = order.size();
+  maxSizeX = 0.0f;
+  for(auto &b : bounds) {
+    maxSizeX = std::max(maxSizeX, b.max[0] - b.min[0]);
+  }
+
+  // insertion-sort, the order from the last frame is usually (almost) correct already
+  for(uint32_t i=1; i<count; ++i) {
+    uint16_t idx = order[i];
+    float minX = bounds[idx].min[0];
+    uint32_t j = i;
+    for(; j > 0 && bounds[order[j-1]].min[0] > minX; --j) {
+      order[j] = order[j-1];
+    }
+    order[j] = idx;
+  }
+  isSorted = true;
+}
+
+const std::vector<P64::Coll::Broadphase::Pair> &P64::Coll::Broadphase::update()
+{
+  sort();
+  uint32_t count = order.size();
+
+  pairs.clear();
+  for(uint32_t i=0; i<count; ++i)
+  {
+    uint16_t idxA = order[i];
+    const auto &bA = bounds[idxA];
+
+    for(uint32_t j=i+1; j<count; ++j)
+    {
+      uint16_t idxB = order[j];
+      const auto &bB = bounds[idxB];
+      if(bB.min[0] > bA.max[0])break; // everything after starts even further right
+
+      if(bA.max[1] < bB.min[1] || bB.max[1] < bA.min[1])continue;
+      if(bA.max[2] < bB.min[2] || bB.max[2] < bA.min[2])continue;
+
+      if(idxA < idxB) {
+        pairs.push_back({idxA, idxB});
+      } else {
+        pairs.push_back({idxB, idxA});
+      }
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end(), [](const Pair &pA, const Pair &pB) {
+    return pA.a != pB.a ? pA.a < pB.a : pA.b < pB.b;
+  });
+  return pairs;
+}
@@ -92,6 +92,33 @@ namespace {
 		return {1.0f - u-v, v, u};
   }
 
+  /**
+   * Signed distances (unscaled) to the precomputed edge-planes, positive means inside.
+   * Same as the barycentric check, but with only 3 dot-products.
+   */
+  fm_vec3_t getEdgeSides(const fm_vec3_t &p, const P64::Coll::Triangle &face)
+  {
+    fm_vec3_t res;
+    for(int i=0; i<3; ++i) {
+      const auto diff = p - face.v[i];
+      const auto &n = face.edgeNormals[i];
+      res.v[i] = diff.x * n.v[0] + diff.y * n.v[1] + diff.z * n.v[2];
+    }
+    return res;
+  }
+
+  bool isInTriangle(const fm_vec3_t &p, const P64::Coll::Triangle &face)
+  {
+    if(face.edgeNormals) {
+      auto sides = getEdgeSides(p, face);
+      return sides.v[0] >= 0.0f && sides.v[1] >= 0.0f && sides.v[2] >= 0.0f;
+    }
+
+    auto baryPos = getTriBaryCoord(p, face.v[0], face.v[1], face.v[2]);
+    return (baryPos.v[0] >= 0.0f) && (baryPos.v[1] >= 0.0f)
+      && ((baryPos.v[0] + baryPos.v[1]) <= 1.0f);
+  }
+
   fm_vec3_t closestPointOnLine(const fm_vec3_t &p, const fm_vec3_t &a, const fm_vec3_t &b)
   {
     const fm_vec3_t lineVec = b - a;
@@ -104,50 +131,65 @@ namespace {
 		return a + (lineDir * clamp(pointDist, 0.0f, length));
   }
 
+  /**
+   * Closest point on any of the edges, returns its squared distance.
+   * Points outside the triangle are always closest to an edge they are outside of,
+   * so with edge-planes all others can be skipped.
+   */
+  float closestPointOnEdges(const fm_vec3_t &p, const P64::Coll::Triangle &face, fm_vec3_t &closestPoint)
+  {
+    fm_vec3_t sides{-1.0f, -1.0f, -1.0f};
+    if(face.edgeNormals)sides = getEdgeSides(p, face);
+
+    float closestDist = INFINITY;
+    for(int i=0; i<3; ++i) {
+      if(sides.v[i] >= 0.0f)continue;
+      const auto point = closestPointOnLine(p, face.v[i], face.v[i == 2 ? 0 : i+1]);
+      const auto dist = t3d_vec3_distance2(&p, &point);
+      if(dist < closestDist) {
+        closestDist = dist;
+        closestPoint = point;
+      }
+    }
+    return closestDist;
+  }
+
+  fm_vec3_t closestPointOnTriangle(const fm_vec3_t &p, const P64::Coll::Triangle &face)
+  {
+    if(isInTriangle(p, face)) {
+      return p - face.normal * pointPlaneDistance(p, face.v[0], face.normal);
+    }
+
+    fm_vec3_t closestPoint{};
+    closestPointOnEdges(p, face, closestPoint);
+    return closestPoint;
+  }
+
   P64::Coll::CollInfo triVsSphere(const P64::Coll::BCS &sphere, const P64::Coll::Triangle &face)
   {
     const auto &bcsPos = sphere.center;
 
-    const auto &vert0 = *face.v[0];
-    const auto &vert1 = *face.v[1];
-    const auto &vert2 = *face.v[2];
-
     // Face tests
-    float planeDist = pointPlaneDistance(bcsPos, vert0, face.normal);
+    float planeDist = pointPlaneDistance(bcsPos, face.v[0], face.normal);
+    // no point of the triangle can be closer than its plane
+    if(fabsf(planeDist) > sphere.getRadius())return {.collCount = 0};
+
     // when we are behind the face (negative), half the distance that is needed to snap back in
     float planeDistAbs = planeDist < 0.0f ? fabsf(planeDist*2.0f) : planeDist;
-    if(planeDistAbs < sphere.getRadius())
+    if(planeDistAbs < sphere.getRadius() && isInTriangle(bcsPos, face))
     {
-      auto baryPos = getTriBaryCoord(bcsPos, vert0, vert1, vert2);
-      const bool isInTri = (baryPos.v[0] >= 0.0f) && (baryPos.v[1] >= 0.0f)
-        && ((baryPos.v[0] + baryPos.v[1]) <= 1.0f);
-
-      if(isInTri)
-      {
-        return {
-          .penetration = face.normal * (planeDist - sphere.getRadius()),
-          .floorWallAngle = face.normal,
-          .collCount = 1
-        };
-      }
+      return {
+        .penetration = face.normal * (planeDist - sphere.getRadius()),
+        .floorWallAngle = face.normal,
+        .collCount = 1
+      };
     }
 
     // Edge test
-    const auto closestPoint1 = closestPointOnLine(bcsPos, vert0, vert1);
-    const auto closestPoint2 = closestPointOnLine(bcsPos, vert1, vert2);
-    const auto closestPoint3 = closestPointOnLine(bcsPos, vert2, vert0);
-
-    const auto closestDist1 = t3d_vec3_distance2(&bcsPos, &closestPoint1);
-    const auto closestDist2 = t3d_vec3_distance2(&bcsPos, &closestPoint2);
-    const auto closestDist3 = t3d_vec3_distance2(&bcsPos, &closestPoint3);
-
-    const float closestDist = fminf(closestDist1, fminf(closestDist2, closestDist3));
+    fm_vec3_t contactPoint{};
+    const float closestDist = closestPointOnEdges(bcsPos, face, contactPoint);
     if(closestDist <= (sphere.getRadius() * sphere.getRadius()))
     {
-      const auto contactPoint = (closestDist == closestDist1)
-        ? closestPoint1
-        : ((closestDist == closestDist2) ? closestPoint2 : closestPoint3);
-
       const auto penVector = contactPoint - bcsPos;
 
       // prevent back-face collision
@@ -172,9 +214,9 @@ namespace {
   P64::Coll::CollInfo triVsBox(const P64::Coll::BCS &box, const P64::Coll::Triangle &face)
   {
     // move triangle to origin
-    const auto v0 = *face.v[0] - box.center;
-    const auto v1 = *face.v[1] - box.center;
-    const auto v2 = *face.v[2] - box.center;
+    const auto v0 = face.v[0] - box.center;
+    const auto v1 = face.v[1] - box.center;
+    const auto v2 = face.v[2] - box.center;
 
     const auto edge0 = v1 - v0;
     const auto edge1 = v2 - v1;
@@ -228,7 +270,7 @@ namespace {
       testAxis(Math::cross(unitAxis0, edge2)) &&
       testAxis(Math::cross(unitAxis1, edge0)) &&
       testAxis(Math::cross(unitAxis1, edge1)) &&
-      testAxis(Math::cross(unitAxis2, edge2)) &&
+      testAxis(Math::cross(unitAxis1, edge2)) &&
       testAxis(Math::cross(unitAxis2, edge0)) &&
       testAxis(Math::cross(unitAxis2, edge1)) &&
       testAxis(Math::cross(unitAxis2, edge2))
@@ -262,12 +304,10 @@ namespace {
   Coll::RaycastRes triVsRay3D(
     const fm_vec3_t &rayStart,
     const fm_vec3_t &dir,
-    const fm_vec3_t &vert0,
-    const fm_vec3_t &vert1,
-    const fm_vec3_t &vert2,
-    const fm_vec3_t &normal
+    const P64::Coll::Triangle &face
   ) {
-    float planeDist = pointPlaneDistance(rayStart, vert0, normal);
+    const auto &normal = face.normal;
+    float planeDist = pointPlaneDistance(rayStart, face.v[0], normal);
     if((planeDist < MIN_PENETRATION) || (t3d_vec3_dot(&dir, &normal) >= 0.0f)) {
       return {};
     }
@@ -275,15 +315,12 @@ namespace {
     float t = planeDist / t3d_vec3_dot(&dir, &normal);
     fm_vec3_t hitPos = rayStart - dir * t;
 
-    auto baryPos = getTriBaryCoord(hitPos, vert0, vert1, vert2);
-    const bool isInTri = (baryPos.v[0] >= 0.0f) && (baryPos.v[1] >= 0.0f)
-      && ((baryPos.v[0] + baryPos.v[1]) <= 1.0f);
-
-    if(isInTri) {
+    if(isInTriangle(hitPos, face)) {
       return {
         .hitPos = hitPos,
         .normal = normal,
-        .flags = 1
+        .flags = 1,
+        .dist = -t
       };
     }
 
@@ -299,18 +336,66 @@ P64::Coll::CollInfo P64::Coll::Mesh::vsBox(const P64::Coll::BCS &box, const P64:
   return triVsBox(box, triangle);
 }
 
-Coll::RaycastRes Coll::Mesh::vsRay(const fm_vec3_t &rayStart, const fm_vec3_t &dir, const P64::Coll::Triangle &face) const
+float P64::Coll::Mesh::sweep(const P64::Coll::BCS &bcs, const fm_vec3_t &motion, const P64::Coll::Triangle &triangle) const
+{
+  constexpr float NO_HIT = 2.0f;
+  constexpr int MAX_ITERATIONS = 12;
+  constexpr int MAX_BOX_STEPS = 16;
+
+  // only the front-side can be hit, same as for the static tests
+  if(t3d_vec3_dot(&motion, &triangle.normal) >= 0.0f)return NO_HIT;
+
+  float motionLen = t3d_vec3_len(&motion);
+  if(motionLen < MIN_PENETRATION)return NO_HIT;
+
+  // Conservative advancement: the body can't get closer than its full speed per time-unit,
+  // so moving by the current distance is always safe. Boxes use their bounding-sphere for that.
+  bool isBox = bcs.flags & BCSFlags::SHAPE_BOX;
+  float radius = isBox ? t3d_vec3_len(&bcs.halfExtend) : bcs.getRadius();
+
+  float t = 0.0f;
+  int iter = 0;
+  for(;; ++iter)
+  {
+    if(iter == MAX_ITERATIONS)return NO_HIT; // only grazing the triangle
+    auto center = bcs.center + motion * t;
+    auto closest = closestPointOnTriangle(center, triangle);
+    float dist = t3d_vec3_distance(&center, &closest) - radius;
+    if(dist <= SWEEP_SKIN)break;
+
+    t += dist / motionLen;
+    if(t >= 1.0f)return NO_HIT;
+  }
+
+  // already touching at the start, this is handled by the regular collision
+  if(iter == 0)return NO_HIT;
+  if(!isBox)return t;
+
+  // box: the bounding-sphere touches, step forward by less than the box thickness until it overlaps
+  float minExtend = Math::min(bcs.halfExtend);
+  float step = fmaxf(minExtend, SWEEP_SKIN) / motionLen;
+  auto box = bcs;
+  for(int i=0; i<MAX_BOX_STEPS && t < 1.0f; ++i, t += step) {
+    box.center = bcs.center + motion * t;
+    if(triVsBox(box, triangle).collCount)return t;
+  }
+  return NO_HIT;
+}
+
+Coll::RaycastRes Coll::Mesh::vsRay(const Ray &ray, const P64::Coll::Triangle &face) const
 {
-  const auto &vert0 = *face.v[0];
-  const auto &vert1 = *face.v[1];
-  const auto &vert2 = *face.v[2];
+  const auto &rayStart = ray.pos;
+  const auto &dir = ray.dir;
+  const auto &vert0 = face.v[0];
+  const auto &vert1 = face.v[1];
+  const auto &vert2 = face.v[2];
 
   // In most cases we want floor ray-casting, which can be  transformed into a 2D case.
   // Otherwise, fallback to a full 3D intersection test.
   // Note that this refers to a downwards-ray in the local space of the mesh.
   //if(fabsf(dir.y) < 0.999f)
   {
-    return triVsRay3D(rayStart, dir, vert0, vert1, vert2, face.normal);
+    return triVsRay3D(rayStart, dir, face);
   }
 
   // raycast the floor, this means we can reduce this to a 2D point vs. triangle test
@@ -333,6 +418,7 @@ Coll::RaycastRes Coll::Mesh::vsRay(const fm_vec3_t &rayStart, const fm_vec3_t &d
   return {
     .hitPos = hitPos,
     .normal = face.normal,
-    .flags = 1
+    .flags = 1,
+    .dist = (hitPos.v[1] - rayStart.v[1]) / dir.v[1]
   };
 }
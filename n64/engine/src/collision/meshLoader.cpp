@@ -11,39 +11,31 @@ namespace {
  }
 
    static void debugDrawBVTreeNode(
-    const int16_t *data, uint32_t basePtr,
-    const P64::Coll::BVHNode *node, int level
+    const P64::Coll::BVH *bvh, const P64::Coll::BVHNode *node,
+    const P64::Coll::AABB &parent, int level
   ) {
-    int dataCount = node->value & 0b1111;
-    int offset = (int16_t)node->value >> 4;
+    auto aabb = node->decode(parent);
     // indent
     for(int i = 0; i < level; i++)debugf("  ");
-    //debugf("%d %d %d - %d %d %d\n", node->aabbMin[0], node->aabbMin[1], node->aabbMin[2], node->aabbMax[0], node->aabbMax[1], node->aabbMax[2]);
-    if(dataCount == 0) {
-      debugDrawBVTreeNode(data, basePtr, &node[offset], level+1);
-      debugDrawBVTreeNode(data, basePtr, &node[offset+1], level+1);
+    debugf("%d %d %d - %d %d %d\n", aabb.min.v[0], aabb.min.v[1], aabb.min.v[2], aabb.max.v[0], aabb.max.v[1], aabb.max.v[2]);
+    if(node->triCount == 0) {
+      debugDrawBVTreeNode(bvh, &bvh->nodes[node->index], aabb, level+1);
+      debugDrawBVTreeNode(bvh, &bvh->nodes[node->index+1], aabb, level+1);
     } else {
       for(int i = 0; i < level; i++)debugf("  ");
-      debugf("## Data: ");
-
-      int offsetEnd = offset + dataCount;
-      while(offset < offsetEnd) {
-        debugf("%d ", data[offset++]);
-      }
-      debugf("\n");
+      debugf("## Triangles: %d - %d\n", node->index, node->index + node->triCount - 1);
     }
   }
 
   [[maybe_unused]] static void debugDrawBVTree(const P64::Coll::BVH *bvh) {
-    const int16_t *data = (int16_t*)&bvh->nodes[bvh->nodeCount]; // data starts right after nodes
-    uint32_t basePtr = (uint32_t)(char*)bvh;
-    debugDrawBVTreeNode(data, basePtr, bvh->nodes, 0);
+    if(bvh->nodeCount)debugDrawBVTreeNode(bvh, bvh->nodes, bvh->bounds, 0);
   }
 }
 
 P64::Coll::Mesh* P64::Coll::Mesh::load(void* rawData)
 {
   Mesh* mesh = (Mesh*)rawData;
+  assertf(mesh->version == VERSION, "Outdated collision data (%08X), rebuild the project", (unsigned)mesh->version);
 
   //debugf("Loading collision mesh %s, size: %d\n", path.c_str(), fileSize);
 
@@ -55,13 +47,19 @@ P64::Coll::Mesh* P64::Coll::Mesh::load(void* rawData)
 
   data += mesh->triCount * sizeof(IVec3);
   data = align(data, 4);
-  mesh->verts = (fm_vec3_t *)data;
+  mesh->edgeNormals = nullptr;
+  if(mesh->flags & FLAG_EDGE_NORMALS) {
+    mesh->edgeNormals = (IVec3*)data;
+    data += mesh->triCount * sizeof(IVec3) * 3;
+    data = align(data, 4);
+  }
+  mesh->verts = (IVec3*)data;
 
-  data += mesh->vertCount * sizeof(fm_vec3_t);
+  data += mesh->vertCount * sizeof(IVec3);
   data = align(data, 4);
   mesh->bvh = (BVH*)data;
 
-  //debugf("BVH: %d nodes, %d data\n", mesh->bvh->nodeCount, mesh->bvh->dataCount);
+  //debugf("BVH: %d nodes, %d triangles\n", mesh->bvh->nodeCount, mesh->triCount);
   //debugDrawBVTree(mesh->bvh);
 
   return mesh;
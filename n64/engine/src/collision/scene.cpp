@@ -3,6 +3,7 @@
  * @license TBD
  */
 #include "collision/scene.h"
+#include <cstring>
 #include "scene/scene.h"
 
 #include "collision/bvh.h"
@@ -16,6 +17,14 @@ namespace
   constexpr float MIN_PENETRATION = 0.00004f;
   constexpr float FLOOR_ANGLE = 0.4f;
 
+  // extra space around the BVH query of a body (relative to its size), results are re-used while inside of it
+  constexpr float CACHE_MARGIN = 0.5f;
+  // max. distance per frame a body can move and still be considered resting
+  constexpr float SLEEP_DIST_SQ = 0.05f * 0.05f;
+  constexpr uint8_t SLEEP_FRAMES = 30;
+  // velocity (per second) a sleeping body ignores, only meant to filter out rounding errors
+  constexpr float WAKE_VELOCITY_SQ = 0.0001f * 0.0001f;
+
   constexpr bool isFloor(const P64::Coll::IVec3 &normal) {
     return normal.v[1] > (int16_t)(0x7FFF * FLOOR_ANGLE);
   }
@@ -25,94 +34,267 @@ namespace
   constexpr bool isFloor(float normY) {
     return normY > FLOOR_ANGLE;
   }
-}
 
-P64::Coll::CollInfo P64::Coll::Scene::vsBCS(BCS &bcs, const fm_vec3_t &velocity, float deltaTime) {
-  float len = fm_vec3_len(&velocity) * deltaTime;
+  // Velocity into the floor a body rests on is ignored, the collision would cancel it anyway (e.g. gravity).
+  // Any other velocity counts, even if it's slow: it adds up over many frames, but a sleeping body stays put.
+  bool hasVelocity(const fm_vec3_t &velocity, uint8_t hitTriTypes)
+  {
+    auto vel = velocity;
+    if((hitTriTypes & P64::Coll::TriType::FLOOR) && vel.y < 0.0f)vel.y = 0.0f;
+    return t3d_vec3_len2(&vel) > WAKE_VELOCITY_SQ;
+  }
 
-  bool isBox = bcs.flags & BCSFlags::SHAPE_BOX;
+  P64::Coll::Triangle getTriangle(const P64::Coll::Mesh &mesh, uint32_t t)
+  {
+    int idxA = mesh.indices[t*3];
+    int idxB = mesh.indices[t*3+1];
+    int idxC = mesh.indices[t*3+2];
+    auto &norm = mesh.normals[t];
+
+    return {
+      .normal = {{
+       (float)norm.v[0] * (1.0f / 32767.0f),
+       (float)norm.v[1] * (1.0f / 32767.0f),
+       (float)norm.v[2] * (1.0f / 32767.0f)
+      }},
+      .v = {mesh.getVert(idxA), mesh.getVert(idxB), mesh.getVert(idxC)},
+      .edgeNormals = mesh.edgeNormals ? &mesh.edgeNormals[t*3] : nullptr
+    };
+  }
 
-  int steps = (int)(len * 1.5f);
-  steps = P64::Math::clamp(steps, 1, 8);
+  // squared distance from a point to the closest point in a box
+  float distToBox2(const fm_vec3_t &p, const fm_vec3_t &boxMin, const fm_vec3_t &boxMax)
+  {
+    auto closest = P64::Math::max(boxMin, P64::Math::min(p, boxMax));
+    return t3d_vec3_distance2(&closest, &p);
+  }
 
-  auto velocityStep = velocity * (deltaTime / steps);
+  bool raySphereHit(const P64::Coll::Ray &ray, const fm_vec3_t &center, float radius, float maxDist)
+  {
+    auto diff = ray.pos - center;
+    float c = t3d_vec3_dot(diff, diff) - radius * radius;
+    if(c <= 0.0f)return true; // starts inside
 
-  P64::Coll::CollInfo res{};
-  P64::Coll::BVHResult bvhRes{};
+    float b = t3d_vec3_dot(diff, ray.dir);
+    if(b > 0.0f)return false; // pointing away
 
-  for(int s=0; s<steps; ++s)
-  {
-    bcs.center = bcs.center + velocityStep;
+    float a = t3d_vec3_dot(ray.dir, ray.dir);
+    float disc = b*b - a*c;
+    if(disc < 0.0f)return false;
+    return (-b - sqrtf(disc)) <= maxDist * a;
+  }
+}
 
-    for(auto meshInst : meshes)
-    {
-      auto &mesh = *meshInst->mesh;
+P64::Coll::CollInfo P64::Coll::Scene::vsBCS(BCS &bcs, BodyState &state, const fm_vec3_t &velocity, float deltaTime) {
+  bool isBox = bcs.flags & BCSFlags::SHAPE_BOX;
+  auto motion = velocity * deltaTime;
 
-      auto bcsLocal = bcs;
-      bcsLocal.center = meshInst->intoLocalSpace(bcs.center);
-      bcsLocal.halfExtend *= meshInst->invScale;
+  P64::Coll::CollInfo res{};
 
-      auto ticksBvhStart = get_ticks();
-      bvhRes.reset();
-      mesh.bvh->vsBCS(bcsLocal, bvhRes);
+  // only check meshes overlapping with the volume the body moves through
+  auto extend = bcs.getBoundsExtend();
+  auto centerEnd = bcs.center + motion;
+  auto sweepMin = Math::min(bcs.center, centerEnd) - extend;
+  auto sweepMax = Math::max(bcs.center, centerEnd) + extend;
+
+  // The BVH query uses a bigger volume than needed, which is cached with its result.
+  // Bodies resting or moving slowly stay inside of it for many frames, re-using the triangles.
+  if(isCacheValid(state, sweepMin, sweepMax)) {
+    ++cacheHits;
+  } else {
+    ++cacheMisses;
+    auto ticksBvhStart = get_ticks();
+    auto margin = extend * CACHE_MARGIN;
+    updateCache(state, sweepMin - margin, sweepMax + margin);
+    ticksBVH += get_ticks() - ticksBvhStart;
+  }
+
+  if(state.meshes.empty()) {
+    bcs.center = centerEnd;
+    return res;
+  }
 
-      ticksBVH += get_ticks() - ticksBvhStart;
-      if(bvhRes.count >= P64::Coll::MAX_RESULT_COUNT-1) {
-        P64::Log::error("BVH result count exceeded max limit (%d)\n", bvhRes.count);
+  // find the first new contact along the way, so fast bodies can't tunnel through thin geometry
+  float toi = 1.0f;
+  fm_vec3_t hitNormal{}; // world-space normal of the triangle hit first
+  uint32_t triIdx = 0;
+  for(uint32_t m=0; m<state.meshes.size(); ++m)
+  {
+    auto meshInst = state.meshes[m];
+    auto &mesh = *meshInst->mesh;
+    auto bcsLocal = bcs;
+    bcsLocal.center = meshInst->intoLocalSpace(bcs.center);
+    bcsLocal.halfExtend *= meshInst->invScale;
+    auto motionLocal = meshInst->invRot * motion * meshInst->invScale;
+
+    for(; triIdx < state.trisEnd[m]; ++triIdx) {
+      auto tri = getTriangle(mesh, state.tris[triIdx]);
+      float triToi = mesh.sweep(bcsLocal, motionLocal, tri);
+      if(triToi < toi) {
+        toi = triToi;
+        hitNormal = meshInst->object->rot * (tri.normal * meshInst->invScale);
       }
+    }
+  }
 
-      for(int b=0; b<bvhRes.count; ++b) {
-        uint32_t t = bvhRes.triIndex[b];
+  // resolve in steps, pushing out of triangles after each one
+  auto resolveSteps = [&](const fm_vec3_t &stepMotion)
+  {
+    int steps = (int)(fm_vec3_len(&stepMotion) * 1.5f);
+    steps = P64::Math::clamp(steps, 1, 8);
+    auto velocityStep = stepMotion * (1.0f / steps);
 
-        int idxA = mesh.indices[t*3];
-        int idxB = mesh.indices[t*3+1];
-        int idxC = mesh.indices[t*3+2];
-        auto &norm = mesh.normals[t];
-
-        Triangle tri{
-          .normal = {{
-           (float)norm.v[0] * (1.0f / 32767.0f),
-           (float)norm.v[1] * (1.0f / 32767.0f),
-           (float)norm.v[2] * (1.0f / 32767.0f)
-          }},
-          .v = {&mesh.verts[idxA], &mesh.verts[idxB], &mesh.verts[idxC]}
-        };
-
-        auto collInfo = isBox
-          ? mesh.vsBox(bcsLocal, tri)
-          : mesh.vsSphere(bcsLocal, tri);
-
-        if(collInfo.collCount)
-        {
-          float penLen2 = t3d_vec3_len2(&collInfo.penetration);
-          if(penLen2 < MIN_PENETRATION)continue;
+    for(int s=0; s<steps; ++s)
+    {
+      bcs.center = bcs.center + velocityStep;
 
-          ++res.collCount;
-          res.penetration = res.penetration + collInfo.penetration;
-          res.meshInstance = meshInst;
+      triIdx = 0;
+      for(uint32_t m=0; m<state.meshes.size(); ++m)
+      {
+        auto meshInst = state.meshes[m];
+        auto &mesh = *meshInst->mesh;
+        uint32_t triEnd = state.trisEnd[m];
+        if(triIdx == triEnd)continue;
 
-          collInfo.floorWallAngle = meshInst->object->rot * collInfo.floorWallAngle;
+        auto bcsLocal = bcs;
+        bcsLocal.center = meshInst->intoLocalSpace(bcs.center);
+        bcsLocal.halfExtend *= meshInst->invScale;
 
-          bool hitFloor = isFloor(collInfo.floorWallAngle.y);
-          bcs.hitTriTypes |= hitFloor ? TriType::FLOOR : TriType::WALL;
-          if(hitFloor) {
-            res.floorWallAngle.y = collInfo.floorWallAngle.y;
-          } else {
-            res.floorWallAngle.x = collInfo.floorWallAngle.x;
-            res.floorWallAngle.z = collInfo.floorWallAngle.z;
+        for(; triIdx < triEnd; ++triIdx)
+        {
+          auto tri = getTriangle(mesh, state.tris[triIdx]);
+          auto collInfo = isBox
+            ? mesh.vsBox(bcsLocal, tri)
+            : mesh.vsSphere(bcsLocal, tri);
+
+          if(collInfo.collCount)
+          {
+            float penLen2 = t3d_vec3_len2(&collInfo.penetration);
+            if(penLen2 < MIN_PENETRATION)continue;
+
+            ++res.collCount;
+            res.penetration = res.penetration + collInfo.penetration;
+            res.meshInstance = meshInst;
+
+            collInfo.floorWallAngle = meshInst->object->rot * collInfo.floorWallAngle;
+
+            bool hitFloor = isFloor(collInfo.floorWallAngle.y);
+            bcs.hitTriTypes |= hitFloor ? TriType::FLOOR : TriType::WALL;
+            if(hitFloor) {
+              res.floorWallAngle.y = collInfo.floorWallAngle.y;
+            } else {
+              res.floorWallAngle.x = collInfo.floorWallAngle.x;
+              res.floorWallAngle.z = collInfo.floorWallAngle.z;
+            }
+
+            bcsLocal.center -= collInfo.penetration;
           }
+        } // triangles
 
-          bcsLocal.center -= collInfo.penetration;
-        }
-      } // BVH res
+        bcs.center = meshInst->outOfLocalSpace(bcsLocal.center);
+      } // meshes
+    } // steps
+  };
 
-      bcs.center = meshInst->outOfLocalSpace(bcsLocal.center);
-    } // meshes
-  } // steps
+  resolveSteps(motion * toi);
+  if(toi >= 1.0f)return res;
+
+  // The sweep stops slightly before the surface. Continue with the rest of the motion projected onto it,
+  // plus enough to close that gap, so the push-out reports the contact in the same frame instead of the next one.
+  fm_vec3_norm(&hitNormal, &hitNormal);
+  auto motionRest = motion * (1.0f - toi);
+  float restInto = t3d_vec3_dot(motionRest, hitNormal);
+  motionRest = motionRest - hitNormal * (restInto + 2.0f * Mesh::SWEEP_SKIN);
+  resolveSteps(motionRest);
 
   return res;
 }
 
+bool P64::Coll::Scene::hasListener(const Object *obj)
+{
+  return obj && obj->collCompMask != 0;
+}
+
+bool P64::Coll::Scene::isCacheValid(const BodyState &state, const fm_vec3_t &min, const fm_vec3_t &max) const
+{
+  if(state.cacheGeneration != meshGeneration)return false;
+  if(min.x < state.cacheMin.x || min.y < state.cacheMin.y || min.z < state.cacheMin.z)return false;
+  if(max.x > state.cacheMax.x || max.y > state.cacheMax.y || max.z > state.cacheMax.z)return false;
+
+  // a mesh that moved into (or inside) the volume has different triangles there now
+  for(auto meshInst : meshesMoved) {
+    if(meshInst->vsAABB(state.cacheMin, state.cacheMax))return false;
+  }
+  return true;
+}
+
+void P64::Coll::Scene::updateCache(BodyState &state, const fm_vec3_t &min, const fm_vec3_t &max)
+{
+  state.cacheMin = min;
+  state.cacheMax = max;
+  state.cacheGeneration = meshGeneration;
+  state.meshes.clear();
+  state.tris.clear();
+  state.trisEnd.clear();
+
+  for(auto meshInst : meshes)
+  {
+    if(!meshInst->vsAABB(min, max))continue;
+
+    // bounds of the (possibly rotated) volume in local space,
+    // BVH nodes are integers, so it gets extended by one unit to not miss anything at the edges
+    fm_vec3_t localMin{INFINITY, INFINITY, INFINITY};
+    fm_vec3_t localMax{-INFINITY, -INFINITY, -INFINITY};
+    for(int i=0; i<8; ++i) {
+      auto corner = meshInst->intoLocalSpace({
+        (i & 1) ? max.x : min.x,
+        (i & 2) ? max.y : min.y,
+        (i & 4) ? max.z : min.z,
+      });
+      localMin = Math::min(localMin, corner);
+      localMax = Math::max(localMax, corner);
+    }
+
+    AABB aabbLocal{};
+    for(int i=0; i<3; ++i) {
+      aabbLocal.min.v[i] = (int16_t)Math::clamp(floorf(localMin.v[i]) - 1.0f, -32768.0f, 32767.0f);
+      aabbLocal.max.v[i] = (int16_t)Math::clamp(ceilf(localMax.v[i]) + 1.0f, -32768.0f, 32767.0f);
+    }
+
+    auto triCount = state.tris.size();
+    meshInst->mesh->bvh->vsAABB(aabbLocal, [&](uint32_t t) {
+      state.tris.push_back(t);
+    });
+    if(state.tris.size() == triCount)continue;
+
+    state.meshes.push_back(meshInst);
+    state.trisEnd.push_back(state.tris.size());
+  }
+}
+
+bool P64::Coll::Scene::updateSleep(BCS &bcs, BodyState &state)
+{
+  if(!state.isSleeping)return false;
+
+  // Anything that would move the body wakes it up, e.g. being moved from the outside, velocity, or a mesh moving nearby.
+  bool restsOnFloor = state.sleepHitTriTypes & TriType::FLOOR;
+  auto moved = bcs.center - state.lastCenter;
+
+  if(hasVelocity(bcs.velocity, state.sleepHitTriTypes) || t3d_vec3_len2(&moved) > SLEEP_DIST_SQ
+    || !isCacheValid(state, state.cacheMin, state.cacheMax))
+  {
+    wakeUp(state);
+    return false;
+  }
+
+  // same result the collision would have had, without doing any of it
+  bcs.hitTriTypes = state.sleepHitTriTypes;
+  if(restsOnFloor && bcs.velocity.y < 0.0f) {
+    bcs.velocity.v[1] = 0.0f;
+  }
+  return true;
+}
+
 fm_vec3_t P64::Coll::MeshInstance::intoLocalSpace(const fm_vec3_t &p) const {
   auto res = (p - object->pos);
   return invRot * res * invScale;
@@ -124,14 +306,42 @@ fm_vec3_t P64::Coll::MeshInstance::outOfLocalSpace(const fm_vec3_t &p) const {
   return object->rot * (p * object->scale) + object->pos;
 }
 
-void P64::Coll::MeshInstance::update()
+bool P64::Coll::MeshInstance::update()
 {
+  bool changed = !isCacheValid
+    || memcmp(&lastPos, &object->pos, sizeof(lastPos)) != 0
+    || memcmp(&lastRot, &object->rot, sizeof(lastRot)) != 0
+    || memcmp(&lastScale, &object->scale, sizeof(lastScale)) != 0;
+
+  if(!changed)return false;
+  lastPos = object->pos;
+  lastRot = object->rot;
+  lastScale = object->scale;
+  isCacheValid = true;
+
   invScale = fm_vec3_t{
     1.0f / object->scale.x,
     1.0f / object->scale.y,
     1.0f / object->scale.z,
   };
   fm_quat_inverse(&invRot, &object->rot);
+
+  // the root of the BVH covers the entire mesh in local space
+  aabbMin = {INFINITY, INFINITY, INFINITY};
+  aabbMax = {-INFINITY, -INFINITY, -INFINITY};
+  if(mesh->bvh->nodeCount == 0)return true;
+
+  auto &localAABB = mesh->bvh->bounds;
+  for(int i=0; i<8; ++i) {
+    auto corner = outOfLocalSpace({
+      (float)((i & 1) ? localAABB.max.v[0] : localAABB.min.v[0]),
+      (float)((i & 2) ? localAABB.max.v[1] : localAABB.min.v[1]),
+      (float)((i & 4) ? localAABB.max.v[2] : localAABB.min.v[2]),
+    });
+    aabbMin = Math::min(aabbMin, corner);
+    aabbMax = Math::max(aabbMax, corner);
+  }
+  return true;
 }
 
 void P64::Coll::Scene::update(float deltaTime)
@@ -139,8 +349,9 @@ void P64::Coll::Scene::update(float deltaTime)
   uint64_t ticksStart = get_ticks();
   auto &gameScene = P64::SceneManager::getCurrent();
 
+  meshesMoved.clear();
   for(auto &inst : meshes) {
-    inst->update();
+    if(inst->update())meshesMoved.push_back(inst);
   }
 
   for(auto sp : collBCS) {
@@ -149,6 +360,7 @@ void P64::Coll::Scene::update(float deltaTime)
 
   for(uint32_t s=0; s < collBCS.size(); ++s) {
     auto &bcsA = collBCS[s];
+    auto &state = bodyStates[s];
 
     // Static/Triangle mesh collision
     bool checkColl = bcsA->isSolid() && !bcsA->isFixed();
@@ -156,8 +368,14 @@ void P64::Coll::Scene::update(float deltaTime)
     // @TODO: use r/w mask
     //bcsA->maskRead & Mask::TRI_MESH;
 
-    if(checkColl) {
-      auto res = vsBCS(*bcsA, bcsA->velocity, deltaTime);
+    if(checkColl && updateSleep(*bcsA, state)) {
+      // keep reporting the contact it fell asleep with
+      if(state.sleepMesh && (state.hasListener || state.sleepMesh->hasListener)) {
+        gameScene.onObjectCollision({bcsA, nullptr, nullptr, state.sleepMesh});
+      }
+    } else if(checkColl) {
+      auto res = vsBCS(*bcsA, state, bcsA->velocity, deltaTime);
+      state.sleepMesh = res.meshInstance;
       if(res.collCount)
       {
         bool hitFloor = bcsA->hitTriTypes & TriType::FLOOR;
@@ -174,124 +392,273 @@ void P64::Coll::Scene::update(float deltaTime)
           }
         }
 
-        // @TODO: don't do if object has no callback
-        gameScene.onObjectCollision({bcsA, nullptr, nullptr, res.meshInstance});
+        if(state.hasListener || res.meshInstance->hasListener) {
+          gameScene.onObjectCollision({bcsA, nullptr, nullptr, res.meshInstance});
+        }
       }
     }
 
-    // Dynamic Colliders
-    for(uint32_t s2=s+1; s2 < collBCS.size(); ++s2)
-    {
-      bool maskMatchA = bcsA->maskRead & collBCS[s2]->maskWrite;
-      bool maskMatchB = collBCS[s2]->maskRead & bcsA->maskWrite;
-      if(!maskMatchA && !maskMatchB)continue;
-
-      auto bcsB = collBCS[s2];
-
-      bool isBoxA = bcsA->flags & BCSFlags::SHAPE_BOX;
-      bool isBoxB = bcsB->flags & BCSFlags::SHAPE_BOX;
+    auto extend = bcsA->getBoundsExtend();
+    auto bMin = bcsA->center - extend;
+    auto bMax = bcsA->center + extend;
+    broadphase.setBounds(s, {
+      .min = {bMin.x, bMin.y, bMin.z},
+      .max = {bMax.x, bMax.y, bMax.z},
+    });
+  }
 
-      bool isColl = false;
+  // Dynamic Colliders, only pairs with overlapping bounds are checked
+  for(auto &pair : broadphase.update())
+  {
+    auto bcsA = collBCS[pair.a];
+    auto bcsB = collBCS[pair.b];
+
+    bool maskMatchA = bcsA->maskRead & bcsB->maskWrite;
+    bool maskMatchB = bcsB->maskRead & bcsA->maskWrite;
+    if(!maskMatchA && !maskMatchB)continue;
+
+    bool isBoxA = bcsA->flags & BCSFlags::SHAPE_BOX;
+    bool isBoxB = bcsB->flags & BCSFlags::SHAPE_BOX;
+
+    bool isColl = false;
+
+    if(!isBoxA && !isBoxB) {
+      isColl = sphereVsSphere(*bcsA, *bcsB);
+    } else if(isBoxA && !isBoxB) {
+      isColl = sphereVsBox(*bcsB, *bcsA);
+    } else if(!isBoxA && isBoxB) {
+      isColl = sphereVsBox(*bcsA, *bcsB);
+    } else {
+      isColl = boxVsBox(*bcsA, *bcsB);
+    }
 
-      if(!isBoxA && !isBoxB) {
-        isColl = sphereVsSphere(*bcsA, *bcsB);
-      } else if(isBoxA && !isBoxB) {
-        isColl = sphereVsBox(*bcsB, *bcsA);
-      } else if(!isBoxA && isBoxB) {
-        isColl = sphereVsBox(*bcsA, *bcsB);
-      } else {
-        isColl = boxVsBox(*bcsA, *bcsB);
-      }
+    if(isColl) {
+      // sleeping bodies get woken up by any active body touching them
+      auto &stateA = bodyStates[pair.a];
+      auto &stateB = bodyStates[pair.b];
+      if(stateA.isSleeping && isActive(*bcsB, stateB))wakeUp(stateA);
+      if(stateB.isSleeping && isActive(*bcsA, stateA))wakeUp(stateB);
 
-      if(isColl) {
-        // @TODO: don't do if object has no callback
+      if(stateA.hasListener || stateB.hasListener) {
         gameScene.onObjectCollision({bcsA, bcsB});
       }
     }
+  }
+
+  for(uint32_t s=0; s < collBCS.size(); ++s) {
+    auto bcs = collBCS[s];
+    auto &state = bodyStates[s];
+    if(bcs->isSolid()) {
+      bcs->obj->pos = bcs->center - bcs->parentOffset;
+    }
 
-    if(bcsA->isSolid()) {
-      bcsA->obj->pos = bcsA->center - bcsA->parentOffset;
+    // bodies that stay in place for a while fall asleep
+    auto moved = bcs->center - state.lastCenter;
+    state.lastCenter = bcs->center;
+    if(state.isSleeping || !isActive(*bcs, state))continue;
+
+    if(t3d_vec3_len2(&moved) > SLEEP_DIST_SQ || hasVelocity(bcs->velocity, bcs->hitTriTypes)) {
+      state.restFrames = 0;
+    } else if(++state.restFrames >= SLEEP_FRAMES) {
+      state.isSleeping = true;
+      state.sleepHitTriTypes = bcs->hitTriTypes;
     }
   }
   ticks += get_ticks() - ticksStart;
 }
 
-P64::Coll::RaycastRes P64::Coll::Scene::raycast(const fm_vec3_t &pos, const fm_vec3_t &dir) {
-  ++raycastCount;
-  P64::Coll::RaycastRes res{};
+void P64::Coll::Scene::raycastMesh(const MeshInstance &meshInst, const Ray &ray, RaycastRes &res, bool anyHit)
+{
+  // same transform for position and direction, so distances are identical in local and world space
+  raycastMeshLocal(meshInst, Ray::create(
+    meshInst.intoLocalSpace(ray.pos),
+    meshInst.invRot * ray.dir * meshInst.invScale
+  ), res, anyHit);
+}
 
-  float highestFloor = -99999.0f;
-  for(auto meshInst : meshes)
+void P64::Coll::Scene::raycastMeshLocal(const MeshInstance &meshInst, const Ray &rayLocal, RaycastRes &res, bool anyHit)
+{
+  auto &mesh = *meshInst.mesh;
+  float maxDist = res.dist;
+  mesh.bvh->raycast(rayLocal, maxDist, [&](uint32_t t)
   {
-    auto &mesh = *meshInst->mesh;
-    auto posLocal = meshInst->intoLocalSpace(pos);
-    auto dirLocal = meshInst->invRot * dir;
-
-    P64::Coll::IVec3 posInt = {
-      .v = {
-        (int16_t)(posLocal.v[0]),
-        (int16_t)(posLocal.v[1]),
-        (int16_t)(posLocal.v[2])
+    auto tri = getTriangle(mesh, t);
+    auto hit = mesh.vsRay(rayLocal, tri);
+    if(hit.hasResult() && hit.dist < maxDist)
+    {
+      // closest-hit: only look for anything closer from now on, any-hit: stop the search entirely
+      maxDist = anyHit ? -INFINITY : hit.dist;
+      res.flags = hit.flags;
+      res.dist = hit.dist;
+      res.hitPos = meshInst.outOfLocalSpace(hit.hitPos);
+      res.normal = meshInst.object->rot * hit.normal;
+    }
+  });
+}
+
+void P64::Coll::Scene::raycastBCS(const Ray &ray, RaycastRes &res)
+{
+  // dynamic colliders (boxes only)
+  for(auto bcs : collBCS)
+  {
+    if(!(bcs->flags & BCSFlags::SHAPE_BOX))continue;
+
+    auto boxMin = bcs->getMinAABB();
+    auto boxMax = bcs->getMaxAABB();
+    float tNear;
+    // rays starting inside a box ignore it, e.g. when casting from an object's own center
+    if(!ray.vsBox(boxMin, boxMax, res.dist, tNear) || tNear < 0.0f || tNear >= res.dist)continue;
+
+    // the axis entered last is the face that got hit
+    int axis = 0;
+    float tAxis = -INFINITY;
+    for(int i=0; i<3; ++i) {
+      float t = ((ray.dir.v[i] > 0.0f ? boxMin.v[i] : boxMax.v[i]) - ray.pos.v[i]) * ray.invDir.v[i];
+      if(t > tAxis) {
+        tAxis = t;
+        axis = i;
       }
-    };
+    }
 
-    P64::Coll::BVHResult bvhRes{};
+    res.flags = 1;
+    res.dist = tNear;
+    res.hitPos = ray.pos + ray.dir * tNear;
+    res.normal = {0.0f, 0.0f, 0.0f};
+    res.normal.v[axis] = ray.dir.v[axis] > 0.0f ? -1.0f : 1.0f;
+  }
+}
 
-    //Debug::drawLine(meshInst->outOfLocalSpace(posLocal), meshInst->outOfLocalSpace(posLocal + dirLocal * 100.0f), color_t{0xFF,0x00,0xFF,0xFF});
+void P64::Coll::Scene::raycastAll(const Ray &ray, RaycastRes &res, bool anyHit)
+{
+  ++raycastCount;
+  float tNear;
+  for(auto meshInst : meshes)
+  {
+    if(!ray.vsBox(meshInst->aabbMin, meshInst->aabbMax, res.dist, tNear))continue;
+    raycastMesh(*meshInst, ray, res, anyHit);
+    if(anyHit && res.hasResult())return;
+  }
+  raycastBCS(ray, res);
+}
 
-    mesh.bvh->raycast(posLocal, dirLocal, bvhRes);
+P64::Coll::RaycastRes P64::Coll::Scene::raycast(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist)
+{
+  RaycastRes res{.dist = maxDist};
+  raycastAll(Ray::create(pos, dir), res, false);
+  return res;
+}
 
-    for(int b=0; b<bvhRes.count; ++b) {
-      uint32_t t = bvhRes.triIndex[b];
-    //for(uint32_t b=0; b<mesh.triCount; ++b) {
-      //uint32_t t = b;
+bool P64::Coll::Scene::raycastAny(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist)
+{
+  RaycastRes res{.dist = maxDist};
+  raycastAll(Ray::create(pos, dir), res, true);
+  return res.hasResult();
+}
 
-      int idxA = mesh.indices[t*3];
-      int idxB = mesh.indices[t*3+1];
-      int idxC = mesh.indices[t*3+2];
-      auto &norm = mesh.normals[t];
+void P64::Coll::Scene::raycastBatch(const Ray *rays, const float *maxDist, RaycastRes *res, uint32_t count)
+{
+  raycastCount += count;
+  for(uint32_t r=0; r<count; ++r) {
+    res[r] = {.dist = maxDist[r]};
+  }
 
-      Triangle tri{
-        .normal = {{
-         (float)norm.v[0] * (1.0f/32767.0f),
-         (float)norm.v[1] * (1.0f/32767.0f),
-         (float)norm.v[2] * (1.0f/32767.0f)
-        }},
-        .v = {&mesh.verts[idxA], &mesh.verts[idxB], &mesh.verts[idxC]}
-      };
+  // Mesh by mesh, so all rays share the same transform and BVH data while it's in cache.
+  // Rotation and scale into local space are turned into a matrix once, which is cheaper per ray than the quaternion.
+  float tNear;
+  for(auto meshInst : meshes)
+  {
+    fm_vec3_t axisLocal[3]; // world axes in local space, i.e. the columns of the matrix
+    for(int i=0; i<3; ++i) {
+      fm_vec3_t axis{};
+      axis.v[i] = 1.0f;
+      axisLocal[i] = meshInst->invRot * axis * meshInst->invScale;
+    }
+    auto intoLocalSpace = [&](const fm_vec3_t &v) {
+      return axisLocal[0] * v.x + axisLocal[1] * v.y + axisLocal[2] * v.z;
+    };
 
-      auto collInfo = mesh.vsRay(posLocal, dirLocal, tri);
-      if(collInfo.hasResult())
-      {
-        res.flags |= collInfo.flags;
-        res.hitPos = meshInst->outOfLocalSpace(collInfo.hitPos);
-        //if(res.hitPos.v[1] > highestFloor)
-        {
-          res.normal = meshInst->object->rot * collInfo.normal;
-          highestFloor = res.hitPos.v[1];
-        }
-      }
+    for(uint32_t r=0; r<count; ++r) {
+      if(!rays[r].vsBox(meshInst->aabbMin, meshInst->aabbMax, res[r].dist, tNear))continue;
+      raycastMeshLocal(*meshInst, Ray::create(
+        intoLocalSpace(rays[r].pos - meshInst->object->pos),
+        intoLocalSpace(rays[r].dir)
+      ), res[r], false);
     }
   }
 
-  // check dynamic colliders (boxes only)
-  for(auto sphere : collBCS) {
-    if(sphere->flags & BCSFlags::SHAPE_BOX) {
-      // inside 2D rect (top-down)
-      if(pos.v[0] >= sphere->getMinAABB().v[0] && pos.v[0] <= sphere->getMaxAABB().v[0] &&
-         pos.v[2] >= sphere->getMinAABB().v[2] && pos.v[2] <= sphere->getMaxAABB().v[2])
-      {
-        float localHeight = sphere->center.v[1] + sphere->halfExtend.v[1];
-        if(localHeight > highestFloor && pos.y > localHeight) {
-          highestFloor = localHeight;
-          res.hitPos = {pos.v[0], localHeight, pos.v[2]};
-          res.normal = {0.0f, 1.0f, 0.0f};
-        }
-      }
+  for(uint32_t r=0; r<count; ++r) {
+    raycastBCS(rays[r], res[r]);
+  }
+}
+
+template<typename F>
+uint32_t P64::Coll::Scene::overlap(const Broadphase::Bounds &area, OverlapRes *res, uint32_t maxRes, uint8_t mask, F &&isHit)
+{
+  uint32_t count = 0;
+  broadphase.query(area, [&](uint32_t idx) {
+    auto bcs = collBCS[idx];
+    if(count >= maxRes || !(bcs->maskWrite & mask))return;
+    if(isHit(*bcs))res[count++] = {bcs, bcs->obj->id};
+  });
+  return count;
+}
+
+uint32_t P64::Coll::Scene::overlapSphere(const fm_vec3_t &center, float radius, OverlapRes *res, uint32_t maxRes, uint8_t mask)
+{
+  return overlap({
+    .min = {center.x - radius, center.y - radius, center.z - radius},
+    .max = {center.x + radius, center.y + radius, center.z + radius},
+  }, res, maxRes, mask, [&](const BCS &bcs) {
+    if(bcs.flags & BCSFlags::SHAPE_BOX) {
+      return distToBox2(center, bcs.getMinAABB(), bcs.getMaxAABB()) <= radius * radius;
+    }
+    float radSum = radius + bcs.getRadius();
+    return t3d_vec3_distance2(&center, &bcs.center) <= radSum * radSum;
+  });
+}
+
+uint32_t P64::Coll::Scene::overlapBox(const fm_vec3_t &center, const fm_vec3_t &halfExtend, OverlapRes *res, uint32_t maxRes, uint8_t mask)
+{
+  auto boxMin = center - halfExtend;
+  auto boxMax = center + halfExtend;
+  return overlap({
+    .min = {boxMin.x, boxMin.y, boxMin.z},
+    .max = {boxMax.x, boxMax.y, boxMax.z},
+  }, res, maxRes, mask, [&](const BCS &bcs) {
+    if(bcs.flags & BCSFlags::SHAPE_BOX) {
+      auto bcsMin = bcs.getMinAABB();
+      auto bcsMax = bcs.getMaxAABB();
+      return bcsMax.x >= boxMin.x && bcsMax.y >= boxMin.y && bcsMax.z >= boxMin.z
+          && bcsMin.x <= boxMax.x && bcsMin.y <= boxMax.y && bcsMin.z <= boxMax.z;
+    }
+    return distToBox2(bcs.center, boxMin, boxMax) <= bcs.getRadius2();
+  });
+}
+
+uint32_t P64::Coll::Scene::overlapRay(const fm_vec3_t &pos, const fm_vec3_t &dir, float maxDist, OverlapRes *res, uint32_t maxRes, uint8_t mask)
+{
+  auto ray = Ray::create(pos, dir);
+
+  // bounds of the whole segment, an infinite ray overlaps everything
+  Broadphase::Bounds area{
+    .min = {-INFINITY, -INFINITY, -INFINITY},
+    .max = {INFINITY, INFINITY, INFINITY},
+  };
+  if(std::isfinite(maxDist)) {
+    auto end = pos + dir * maxDist;
+    for(int i=0; i<3; ++i) {
+      area.min[i] = fminf(pos.v[i], end.v[i]);
+      area.max[i] = fmaxf(pos.v[i], end.v[i]);
     }
   }
 
-  return res;
+  return overlap(area, res, maxRes, mask, [&](const BCS &bcs) {
+    if(bcs.flags & BCSFlags::SHAPE_BOX) {
+      float tNear;
+      return ray.vsBox(bcs.getMinAABB(), bcs.getMaxAABB(), maxDist, tNear);
+    }
+    return raySphereHit(ray, bcs.center, bcs.getRadius(), maxDist);
+  });
 }
 
 void P64::Coll::Scene::debugDraw(bool showMesh, bool showSpheres)
@@ -303,9 +670,9 @@ void P64::Coll::Scene::debugDraw(bool showMesh, bool showSpheres)
         int idxA = mesh.indices[t*3];
         int idxB = mesh.indices[t*3+1];
         int idxC = mesh.indices[t*3+2];
-        auto v0 = (mesh.verts[idxA] * meshInst->object->scale + meshInst->object->pos);
-        auto v1 = (mesh.verts[idxB] * meshInst->object->scale + meshInst->object->pos);
-        auto v2 = (mesh.verts[idxC] * meshInst->object->scale + meshInst->object->pos);
+        auto v0 = (mesh.getVert(idxA) * meshInst->object->scale + meshInst->object->pos);
+        auto v1 = (mesh.getVert(idxB) * meshInst->object->scale + meshInst->object->pos);
+        auto v2 = (mesh.getVert(idxC) * meshInst->object->scale + meshInst->object->pos);
 
         if(mesh.normals[t].v[2] < 0)continue;
         auto color = isFloor(mesh.normals[t])
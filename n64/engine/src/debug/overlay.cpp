@@ -243,6 +243,10 @@ void Debug::Overlay::draw(P64::Scene &scene, surface_t* surf)
   Debug::printf(posX-32, posY, "H:%dkb", heap_stats.used);
   Debug::printf(posX, posY+8, "O:%d\n", scene.getObjectCount());
 
+  // scene arena, used / taken from the heap
+  auto &arenaStats = scene.getArena().getStats();
+  Debug::printf(posX-32, posY+16, "S:%d/%dkb", (int)arenaStats.bytesUsed / 1024, (int)arenaStats.bytesReserved / 1024);
+
   posX = 24;
 
   // Menu
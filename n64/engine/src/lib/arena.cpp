@@ -0,0 +1,112 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "lib/arena.h"
+#include "lib/math.h"
+#include <algorithm>
+
+namespace
+{
+  // in front of each allocation, overlaps with 'FreeBlock' while in a free-list
+  struct BlockHeader
+  {
+    uint32_t sizeClass;
+    uint32_t size; // incl. header
+  };
+  static_assert(sizeof(BlockHeader) == P64::Mem::Arena::HEADER_SIZE);
+}
+
+namespace P64::Mem
+{
+  void* Arena::allocFromChunk(uint32_t size)
+  {
+    if(chunkPos + size > chunkEnd)
+    {
+      // hand out the rest of the old chunk as free blocks, largest first
+      uint32_t left = chunkEnd - chunkPos;
+      for(int sc=CLASS_COUNT-1; sc >= 0; --sc) {
+        while(left >= CLASS_SIZES[sc]) {
+          auto block = (FreeBlock*)chunkPos;
+          block->next = freeLists[sc];
+          freeLists[sc] = block;
+          chunkPos += CLASS_SIZES[sc];
+          left -= CLASS_SIZES[sc];
+        }
+      }
+
+      chunkPos = (uint8_t*)memalign(16, CHUNK_SIZE);
+      chunkEnd = chunkPos + CHUNK_SIZE;
+      blocks.push_back(chunkPos);
+      ++stats.chunkCount;
+      stats.bytesReserved += CHUNK_SIZE;
+    }
+
+    auto res = chunkPos;
+    chunkPos += size;
+    return res;
+  }
+
+  void* Arena::alloc(uint32_t size)
+  {
+    uint32_t fullSize = Math::alignUp(size + sizeof(BlockHeader), 8);
+    uint32_t sc = getSizeClass(fullSize);
+    BlockHeader *block;
+
+    if(sc == LARGE_CLASS) {
+      block = (BlockHeader*)memalign(16, fullSize);
+      blocks.push_back(block);
+      stats.bytesReserved += fullSize;
+    } else {
+      fullSize = CLASS_SIZES[sc];
+      if(freeLists[sc]) {
+        block = (BlockHeader*)freeLists[sc];
+        freeLists[sc] = freeLists[sc]->next;
+        ++stats.freeListHits;
+      } else {
+        block = (BlockHeader*)allocFromChunk(fullSize);
+      }
+    }
+
+    block->sizeClass = sc;
+    block->size = fullSize;
+
+    ++stats.allocCount;
+    stats.bytesUsed += fullSize;
+    stats.bytesUsedPeak = Math::max(stats.bytesUsedPeak, stats.bytesUsed);
+    return block + 1;
+  }
+
+  void Arena::free(void* ptr)
+  {
+    if(!ptr)return;
+    auto block = (BlockHeader*)ptr - 1;
+
+    --stats.allocCount;
+    stats.bytesUsed -= block->size;
+
+    if(block->sizeClass == LARGE_CLASS) {
+      stats.bytesReserved -= block->size;
+      std::erase(blocks, block);
+      ::free(block);
+      return;
+    }
+
+    uint32_t sc = block->sizeClass; // header gets overwritten by the free-list
+    auto freeBlock = (FreeBlock*)block;
+    freeBlock->next = freeLists[sc];
+    freeLists[sc] = freeBlock;
+  }
+
+  void Arena::reset()
+  {
+    for(auto block : blocks) {
+      ::free(block);
+    }
+    blocks.clear();
+    std::fill(std::begin(freeLists), std::end(freeLists), nullptr);
+    chunkPos = nullptr;
+    chunkEnd = nullptr;
+    stats = {};
+  }
+}
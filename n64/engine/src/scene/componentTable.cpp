@@ -4,6 +4,7 @@
 */
 #include "scene/componentTable.h"
 #include "scene/scene.h"
+#include <algorithm>
 #include <type_traits>
 
 #include "scene/components/code.h"
@@ -37,6 +38,40 @@ namespace
   HAS_FUNC_TPL(has_update, get_update,  update )
   HAS_FUNC_TPL(has_event,  get_event,   onEvent)
   HAS_FUNC_TPL(has_coll,   get_coll,    onColl )
+
+  template<typename T, typename = void>
+  struct has_prio : std::false_type {};
+
+  template<typename T>
+  struct has_prio<T, std::void_t<decltype(T::PRIO)>> : std::true_type {};
+
+  template<typename T>
+  constexpr int8_t get_prio() {
+    if constexpr (has_prio<T>::value) { return T::PRIO; } else { return 0; }
+  }
+
+  template<typename T, typename = void>
+  struct has_prio_update : std::false_type {};
+
+  template<typename T>
+  struct has_prio_update<T, std::void_t<decltype(T::PRIO_UPDATE)>> : std::true_type {};
+
+  template<typename T>
+  constexpr int8_t get_prio_update() {
+    if constexpr (has_prio_update<T>::value) { return T::PRIO_UPDATE; } else { return get_prio<T>(); }
+  }
+
+  template<int8_t P64::ComponentDef::*PRIO>
+  std::array<uint8_t, P64::COMP_TABLE_SIZE> sortByPrio()
+  {
+    using P64::COMP_TABLE;
+    std::array<uint8_t, P64::COMP_TABLE_SIZE> res{};
+    for(uint32_t i=0; i<P64::COMP_TABLE_SIZE; ++i)res[i] = i;
+    std::stable_sort(res.begin(), res.end(), [](uint8_t a, uint8_t b) {
+      return COMP_TABLE[a].*PRIO < COMP_TABLE[b].*PRIO;
+    });
+    return res;
+  }
 }
 
 #define SET_COMP(NAME) \
@@ -47,6 +82,8 @@ namespace
     .onEvent = (FuncOnEvent)(get_event<Comp::NAME>()), \
     .onColl = (FuncOnColl)(get_coll<Comp::NAME>()), \
     .getAllocSize = reinterpret_cast<FuncGetAllocSize>(Comp::NAME::getAllocSize), \
+    .prio = get_prio<Comp::NAME>(), \
+    .prioUpdate = get_prio_update<Comp::NAME>(), \
   }
 
 namespace P64
@@ -64,4 +101,7 @@ namespace P64
     SET_COMP(NodeGraph),
     SET_COMP(AnimModel),
   };
+
+  const std::array<uint8_t, COMP_TABLE_SIZE> COMP_ORDER_UPDATE = sortByPrio<&ComponentDef::prioUpdate>();
+  const std::array<uint8_t, COMP_TABLE_SIZE> COMP_ORDER_DRAW = sortByPrio<&ComponentDef::prio>();
 }
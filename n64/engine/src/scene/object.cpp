@@ -28,6 +28,7 @@ void P64::Object::setEnabled(bool isEnabled)
   }
 
   if(oldFlags == flags)return;
+  getScene().compActiveDirty = true;
 
   auto compRefs = getCompRefs();
   for (uint32_t i=0; i<compCount; ++i) {
@@ -46,9 +47,6 @@ void P64::Object::setEnabled(bool isEnabled)
 
 void P64::Object::remove()
 {
-  if(flags & ObjectFlags::PENDING_REMOVE)return;
-  flags |= ObjectFlags::PENDING_REMOVE;
-  flags &= ~ObjectFlags::ACTIVE;
   SceneManager::getCurrent().removeObject(*this);
 }
 
@@ -34,6 +34,33 @@ namespace
 #if RSPQ_PROFILE
   uint32_t frameCount = 0;
 #endif
+
+  void dispatchCollision(P64::Object &obj, const P64::Coll::CollEvent &event)
+  {
+    auto compRefs = obj.getCompRefs();
+    for (uint32_t i=0; i<obj.compCount; ++i)
+    {
+      uint32_t bit = 1u << P64::Math::min<uint32_t>(i, 31);
+      if(obj.collCompMask < bit)break; // no listener left
+      if(!(obj.collCompMask & bit))continue;
+
+      const auto &compDef = P64::COMP_TABLE[compRefs[i].type];
+      if(compDef.onColl) {
+        char* dataPtr = (char*)&obj + compRefs[i].offset;
+        compDef.onColl(obj, dataPtr, event);
+      }
+    }
+  }
+
+  // children are only active if all of their parents are, walks the whole subtree
+  void updateParentsActive(P64::Object &parent)
+  {
+    bool isActive = parent.isEnabled();
+    for(auto child = parent.firstChild; child; child = child->nextSibling) {
+      child->setFlag(P64::ObjectFlags::PARENTS_ACTIVE, isActive);
+      if(child->firstChild)updateParentsActive(*child);
+    }
+  }
 }
 
 P64::Scene::Scene(uint16_t sceneId, Scene** ref)
@@ -44,6 +71,10 @@ P64::Scene::Scene(uint16_t sceneId, Scene** ref)
 
   loadSceneConfig();
 
+  // spawned objects must not collide with the ones from the scene file
+  nextId = Math::max(nextId, conf.maxObjectId);
+  idPages.resize((conf.maxObjectId / ID_PAGE_SIZE) + 1, nullptr);
+
   DrawLayer::init(conf.layerSetup);
 
   switch(conf.pipeline)
@@ -95,10 +126,11 @@ P64::Scene::~Scene()
 {
   rspq_wait();
 
+  // memory itself is freed at once by the arena
   for(auto obj : objects) {
     obj->~Object();
-    free(obj);
   }
+  arena.reset();
 
   AudioManager::stopAll();
   MatrixManager::reset();
@@ -150,16 +182,12 @@ void P64::Scene::update(float deltaTime)
   ticksGlobalUpdate = get_user_ticks() - ticksGlobalUpdate;
 
   ticksActorUpdate = get_ticks();
-  for(auto obj : objects)
+  for(auto type : COMP_ORDER_UPDATE)
   {
-    if(!obj->isEnabled())continue;
-
-    auto compRefs = obj->getCompRefs();
-
-    for (uint32_t i=0; i<obj->compCount; ++i) {
-      const auto &compDef = COMP_TABLE[compRefs[i].type];
-      char* dataPtr = (char*)obj + compRefs[i].offset;
-      compDef.update(*obj, dataPtr, deltaTime);
+    auto funcUpdate = COMP_TABLE[type].update;
+    for(auto &comp : compUpdateList[type]) {
+      if(compActiveDirty)syncCompActive(); // an earlier update may have (de)activated objects
+      if(comp.active)funcUpdate(*comp.obj, comp.data, deltaTime);
     }
   }
 
@@ -171,14 +199,7 @@ void P64::Scene::update(float deltaTime)
 
   collScene.update(deltaTime);
 
-  for(auto &obj : pendingObjDelete)
-  {
-    idLookup[obj->id] = nullptr;
-    std::erase(objects, obj);
-    obj->~Object();
-    free(obj);
-  }
-  pendingObjDelete.clear();
+  if(!pendingObjDelete.empty())deletePendingObjects();
 
   // events, switch now to prevent infinite loops for objects that push events in response to events
   auto &evQueue = eventQueue[eventQueueIdx];
@@ -233,26 +254,21 @@ void P64::Scene::draw([[maybe_unused]] float deltaTime)
 
     GlobalScript::callHooks(GlobalScript::HookType::SCENE_PRE_DRAW_3D);
 
-    //debugf("Drawing objects:\n");
-    for(auto obj : objects)
+    // culling sorts before any drawing, so culled objects are known by the time models get drawn
+    for(auto type : COMP_ORDER_DRAW)
     {
-      //debugf(" - %d\n", obj->id);
-      if(!obj->isEnabled())continue;
-      auto compRefs = obj->getCompRefs();
-
-      for (uint32_t i=0; i<obj->compCount; ++i)
-      {
-        if(obj->flags & ObjectFlags::IS_CULLED)break;
-        const auto &compDef = COMP_TABLE[compRefs[i].type];
-        if(compDef.draw)
-        {
-          char* dataPtr = (char*)obj + compRefs[i].offset;
-          compDef.draw(*obj, dataPtr, deltaTime);
+      auto funcDraw = COMP_TABLE[type].draw;
+      for(auto &comp : compDrawList[type]) {
+        if(compActiveDirty)syncCompActive();
+        if(comp.active && !(comp.obj->flags & ObjectFlags::IS_CULLED)) {
+          funcDraw(*comp.obj, comp.data, deltaTime);
         }
       }
+    }
 
-      // culling resets directly after a draw, otherwise objects can get stuck culled.
-      // this is also needed to handle multiple cameras correctly.
+    // culling resets directly after a draw, otherwise objects can get stuck culled.
+    // this is also needed to handle multiple cameras correctly.
+    for(auto obj : objects) {
       obj->setFlag(ObjectFlags::IS_CULLED, false);
     }
 
@@ -293,15 +309,8 @@ void P64::Scene::onObjectCollision(const Coll::CollEvent &event)
   auto objB = event.otherBCS ? event.otherBCS->obj : event.otherMesh->object;
   if(!objA || !objB)return;
 
-  auto compRefsA = objA->getCompRefs();
-  for (uint32_t i=0; i<objA->compCount; ++i)
-  {
-    const auto &compDef = COMP_TABLE[compRefsA[i].type];
-    if(compDef.onColl) {
-      char* dataPtr = (char*)objA + compRefsA[i].offset;
-      compDef.onColl(*objA, dataPtr, event);
-    }
-  }
+  if(objA->collCompMask)dispatchCollision(*objA, event);
+  if(!objB->collCompMask)return;
 
   //if(!event.otherBCS)return;
 
@@ -311,16 +320,7 @@ void P64::Scene::onObjectCollision(const Coll::CollEvent &event)
     .selfMesh = event.otherMesh,
     .otherMesh = event.selfMesh,
   };
-
-  auto compRefsB = objB->getCompRefs();
-  for (uint32_t i=0; i<objB->compCount; ++i)
-  {
-    const auto &compDef = COMP_TABLE[compRefsB[i].type];
-    if(compDef.onColl) {
-      char* dataPtr = (char*)objB + compRefsB[i].offset;
-      compDef.onColl(*objB, dataPtr, eventOther);
-    }
-  }
+  dispatchCollision(*objB, eventOther);
 }
 
 uint16_t P64::Scene::addObject(
@@ -340,42 +340,111 @@ uint16_t P64::Scene::addObject(
   return nextId;
 }
 
+void P64::Scene::addToCompLists(Object &obj)
+{
+  auto compRefs = obj.getCompRefs();
+  for (uint32_t i=0; i<obj.compCount; ++i)
+  {
+    auto type = compRefs[i].type;
+    CompInstance comp{&obj, (char*)&obj + compRefs[i].offset, obj.isEnabled()};
+    if(COMP_TABLE[type].update)compUpdateList[type].push_back(comp);
+    if(COMP_TABLE[type].draw)compDrawList[type].push_back(comp);
+  }
+}
+
+void P64::Scene::syncCompActive()
+{
+  // changes are rare compared to the per-frame loops, so a single pass over everything is cheaper
+  // than searching the entries of each changed object (and its children for groups)
+  compActiveDirty = false;
+  for(auto &list : compUpdateList) {
+    for(auto &comp : list)comp.active = comp.obj->isEnabled();
+  }
+  for(auto &list : compDrawList) {
+    for(auto &comp : list)comp.active = comp.obj->isEnabled();
+  }
+}
+
+void P64::Scene::deletePendingObjects()
+{
+  // objects are flagged, so each list only needs a single compacting pass no matter how many get deleted.
+  // this also keeps the order of the remaining objects.
+  auto isPending = [](const Object *obj) { return obj->flags & ObjectFlags::PENDING_REMOVE; };
+  auto isPendingComp = [](const CompInstance &comp) { return comp.obj->flags & ObjectFlags::PENDING_REMOVE; };
+
+  static_assert(COMP_TABLE_SIZE <= 32);
+  uint32_t typeMask = 0;
+  for(auto obj : pendingObjDelete) {
+    auto compRefs = obj->getCompRefs();
+    for (uint32_t i=0; i<obj->compCount; ++i) {
+      typeMask |= 1u << compRefs[i].type;
+    }
+  }
+
+  for(uint32_t type=0; type<COMP_TABLE_SIZE; ++type) {
+    if(!(typeMask & (1u << type)))continue;
+    std::erase_if(compUpdateList[type], isPendingComp);
+    std::erase_if(compDrawList[type], isPendingComp);
+  }
+  std::erase_if(objects, isPending);
+
+  // before any gets destroyed, parents and siblings may be part of the same batch
+  for(auto obj : pendingObjDelete) {
+    unlinkFromParent(*obj);
+  }
+
+  for(auto obj : pendingObjDelete) {
+    setObjectById(obj->id, nullptr);
+    obj->~Object();
+    arena.free(obj); // re-used by the next object of a similar size
+  }
+  pendingObjDelete.clear();
+}
+
 void P64::Scene::removeObject(Object &obj)
 {
+  if(obj.flags & ObjectFlags::PENDING_REMOVE)return;
+  obj.flags |= ObjectFlags::PENDING_REMOVE;
+  obj.flags &= ~ObjectFlags::ACTIVE; // no disable event, components get destroyed soon anyway
+  compActiveDirty = true;
   pendingObjDelete.push_back(&obj);
 }
 
-P64::Object* P64::Scene::getObjectById(uint16_t objId) const
+void P64::Scene::setObjectById(uint16_t objId, Object *obj)
 {
-  // the first IDs get a direct lookup, under the assumption most
-  // scenes keep object count in a reasonable amount
-  if(objId < idLookup.size()) {
-    return idLookup[objId];
+  uint32_t page = objId / ID_PAGE_SIZE;
+  if(page >= idPages.size()) {
+    if(!obj)return;
+    idPages.resize(page + 1, nullptr);
   }
 
-  // otherwise fallback to a linear scan
-  for(auto obj : objects) {
-    if (objId == obj->id) {
-      return obj;
-    }
+  if(!idPages[page]) {
+    if(!obj)return;
+    idPages[page] = (Object**)arena.alloc(sizeof(Object*) * ID_PAGE_SIZE);
+    memset(idPages[page], 0, sizeof(Object*) * ID_PAGE_SIZE);
   }
-  return nullptr;
+  idPages[page][objId % ID_PAGE_SIZE] = obj;
 }
 
-void P64::Scene::setGroupEnabled(uint16_t groupId, bool enabled) const
+void P64::Scene::linkToParent(Object &obj)
+{
+  ObjectHierarchy::link(obj, [this](uint16_t parentId) { return getChildList(parentId); });
+}
+
+void P64::Scene::unlinkFromParent(Object &obj)
+{
+  ObjectHierarchy::unlink(obj, [this](uint16_t parentId) { return getChildList(parentId); });
+}
+
+void P64::Scene::setGroupEnabled(uint16_t groupId, bool enabled)
 {
   if(groupId == 0)return;
+  auto group = getObjectById(groupId);
+  if(!group)return;
 
-  for(auto obj : objects)
-  {
-    if (groupId == obj->id) {
-      obj->setFlag(ObjectFlags::SELF_ACTIVE, enabled);
-    }
-    if (groupId == obj->group) {
-      //debugf("-> obj %d active = %d\n", obj->id, enabled);
-      obj->setFlag(ObjectFlags::PARENTS_ACTIVE, enabled);
-    }
-  }
+  group->setFlag(ObjectFlags::SELF_ACTIVE, enabled);
+  updateParentsActive(*group);
+  compActiveDirty = true;
 }
 
 P64::Lighting & P64::Scene::startLightingOverride(bool copyExisting)
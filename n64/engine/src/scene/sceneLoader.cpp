@@ -78,6 +78,7 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
   auto ptrIn = objFile + sizeof(ObjectEntry);
   uint32_t compCount = 0;
   uint32_t compDataSize = 0;
+  uint32_t collCompMask = 0;
   while(ptrIn[1] != 0) {
     auto compId = ptrIn[0];
     auto argSize = ptrIn[1] * 4;
@@ -87,6 +88,7 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
     assertf(compDef.getAllocSize != nullptr, "Component %d unknown!", compId);
     compDataSize += Math::alignUp(compDef.getAllocSize(ptrIn + 4), DATA_ALIGN);
     allocSize += sizeof(Object::CompRef);
+    if(compDef.onColl)collCompMask |= 1u << Math::min<uint32_t>(compCount, 31);
 
     ptrIn += argSize;
     ++compCount;
@@ -105,7 +107,7 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
 
   //debugf("Allocating object %d | comps: %d | size: %lu bytes\n", objEntry->id, compCount, allocSize);
 
-  void* objMem = memalign(DATA_ALIGN, allocSize); // @TODO: custom allocator
+  void* objMem = arena.alloc(allocSize);
   if(allocSize < 16) {
     memset(objMem, 0, allocSize);
   } else {
@@ -120,6 +122,7 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
   obj->group = objEntry->group;
   obj->flags = objEntry->flags;
   obj->compCount = compCount;
+  obj->collCompMask = collCompMask; // set before any init, colliders check it when registering
   obj->pos = objEntry->pos;
   obj->scale = objEntry->scale;
   obj->rot = Math::unpackQuat(objEntry->packedRot);
@@ -154,7 +157,9 @@ P64::Object* P64::Scene::loadObject(uint8_t* &objFile, std::function<void(Object
   objFile = ptrIn + 4;
 
   objects.push_back(obj);
-  idLookup[obj->id] = obj;
+  setObjectById(obj->id, obj);
+  linkToParent(*obj);
+  addToCompLists(*obj);
 
   return obj;
 }
@@ -179,8 +184,8 @@ void P64::Scene::loadScene() {
     free(objFileStart);
   }
 
-  // update groups
-  for(auto obj : objects)
+  // update groups, starting at the top-level ones visits each object once
+  for(auto obj = rootFirstChild; obj; obj = obj->nextSibling)
   {
     if(obj->hasChildren())
     {
@@ -26,23 +26,28 @@ bool Build::buildAudioAssets(Project::Project &project, SceneCtx &sceneCtx)
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(asset.outPath));
 
-    if(!assetBuildNeeded(asset, outPath))continue;
-
-    std::string cmd = mkAudio.string();
-    if(asset.conf.wavForceMono.value) {
-      cmd += " --wav-mono";
-    }
-    if(asset.conf.wavResampleRate.value != 0) {
-      cmd += " --wav-resample " + std::to_string(asset.conf.wavResampleRate.value);
-    }
-
-    cmd += " --wav-compress " + std::to_string(asset.conf.wavCompression.value);
-    cmd += " -o \"" + outDir.string() + "\"";
-    cmd += " \"" + asset.path + "\"";
-
-    if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-      return false;
-    }
+    auto toolId = sceneCtx.buildCache.getToolId(mkAudio);
+
+    sceneCtx.jobs.add(asset.path, [&sceneCtx, &asset, mkAudio, outPath, outDir, toolId]()
+    {
+      if(!assetBuildNeeded(sceneCtx, asset, outPath, toolId))return true;
+
+      std::string cmd = mkAudio.string();
+      if(asset.conf.wavForceMono.value) {
+        cmd += " --wav-mono";
+      }
+      if(asset.conf.wavResampleRate.value != 0) {
+        cmd += " --wav-resample " + std::to_string(asset.conf.wavResampleRate.value);
+      }
+
+      cmd += " --wav-compress " + std::to_string(asset.conf.wavCompression.value);
+      cmd += " -o \"" + outDir.string() + "\"";
+      cmd += " \"" + asset.path + "\"";
+
+      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd))return false;
+      assetBuildDone(sceneCtx, outPath);
+      return true;
+    });
   }
   return true;
 }
\ No newline at end of file
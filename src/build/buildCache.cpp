@@ -0,0 +1,156 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "buildCache.h"
+
+#include <format>
+#include "json.hpp"
+#include "../utils/fs.h"
+#include "../utils/hash.h"
+#include "../utils/logger.h"
+
+namespace
+{
+  // bump to invalidate all existing caches
+  constexpr int DB_VERSION = 1;
+
+  std::string key(const fs::path &path) {
+    return Utils::FS::toUnixPath(path.lexically_normal());
+  }
+}
+
+void Build::BuildCache::load(const fs::path &dbPath)
+{
+  std::lock_guard lock{mtx};
+  path = dbPath;
+  entries.clear();
+  pending.clear();
+  dirty = false;
+
+  auto data = Utils::FS::loadTextFile(dbPath);
+  if(data.empty())return;
+
+  nlohmann::json doc{};
+  try {
+    doc = nlohmann::json::parse(data);
+  } catch(const std::exception &e) {
+    Utils::Logger::log("Build-cache corrupt, rebuilding all assets: " + std::string(e.what()), Utils::Logger::LEVEL_WARN);
+    return;
+  }
+
+  if(!doc.is_object() || doc.value("version", 0) != DB_VERSION)return;
+
+  for(auto &[outPath, e] : doc["entries"].items()) {
+    entries[outPath] = {
+      .key = e.value<uint64_t>("key", 0),
+      .srcHash = e.value<uint64_t>("srcHash", 0),
+      .srcTime = e.value<uint64_t>("srcTime", 0),
+      .srcSize = e.value<uint64_t>("srcSize", 0),
+    };
+  }
+}
+
+void Build::BuildCache::save()
+{
+  std::lock_guard lock{mtx};
+  if(!dirty || path.empty())return;
+
+  nlohmann::json docEntries = nlohmann::json::object();
+  for(auto &[outPath, e] : entries) {
+    docEntries[outPath] = {
+      {"key", e.key},
+      {"srcHash", e.srcHash},
+      {"srcTime", e.srcTime},
+      {"srcSize", e.srcSize},
+    };
+  }
+
+  nlohmann::json doc{
+    {"version", DB_VERSION},
+    {"entries", docEntries},
+  };
+
+  fs::create_directories(path.parent_path());
+  Utils::FS::saveTextFile(path, doc.dump());
+  dirty = false;
+}
+
+bool Build::BuildCache::isUpToDate(const fs::path &outPath, const fs::path &srcPath, const std::string &buildKey)
+{
+  std::error_code ecTime{}, ecSize{};
+  Entry newEntry{
+    .srcTime = (uint64_t)fs::last_write_time(srcPath, ecTime).time_since_epoch().count(),
+    .srcSize = (uint64_t)fs::file_size(srcPath, ecSize),
+  };
+  if(ecTime || ecSize)return false;
+
+  auto outKey = key(outPath);
+  Entry oldEntry{};
+  bool hasEntry = false;
+  {
+    std::lock_guard lock{mtx};
+    auto it = entries.find(outKey);
+    if(it != entries.end()) {
+      oldEntry = it->second;
+      hasEntry = true;
+    }
+  }
+
+  // source untouched since the last check, no need to read it again
+  if(hasEntry && oldEntry.srcTime == newEntry.srcTime && oldEntry.srcSize == newEntry.srcSize) {
+    newEntry.srcHash = oldEntry.srcHash;
+  } else {
+    newEntry.srcHash = Utils::Hash::sha256_64bit(Utils::FS::loadTextFile(srcPath));
+  }
+
+  newEntry.key = Utils::Hash::sha256_64bit(
+    std::format("{:016X}|{}", newEntry.srcHash, buildKey)
+  );
+
+  bool upToDate = hasEntry && oldEntry.key == newEntry.key && fs::exists(outPath);
+
+  std::lock_guard lock{mtx};
+  if(upToDate) {
+    // keep the timestamp current, e.g. after a checkout that only touched the file
+    if(oldEntry.srcTime != newEntry.srcTime) {
+      entries[outKey] = newEntry;
+      dirty = true;
+    }
+  } else {
+    pending[outKey] = newEntry;
+  }
+  return upToDate;
+}
+
+void Build::BuildCache::markBuilt(const fs::path &outPath)
+{
+  std::lock_guard lock{mtx};
+  auto it = pending.find(key(outPath));
+  if(it == pending.end())return;
+
+  entries[it->first] = it->second;
+  pending.erase(it);
+  dirty = true;
+}
+
+const std::string &Build::BuildCache::getToolId(const fs::path &toolPath)
+{
+  std::lock_guard lock{mtx};
+  auto pathStr = toolPath.string();
+  auto it = toolIds.find(pathStr);
+  if(it != toolIds.end())return it->second;
+
+  auto exePath = toolPath;
+  if(!fs::exists(exePath))exePath += ".exe";
+
+  std::error_code ecTime{}, ecSize{};
+  auto time = fs::last_write_time(exePath, ecTime).time_since_epoch().count();
+  auto size = fs::file_size(exePath, ecSize);
+  if(ecTime || ecSize) {
+    time = 0;
+    size = 0;
+  }
+
+  return toolIds[pathStr] = std::format("{}:{}:{}", pathStr, size, time);
+}
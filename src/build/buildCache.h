@@ -0,0 +1,71 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace Build
+{
+  /**
+   * Persistent database of built assets, stored in the build directory of a project.
+   * Each output is keyed by a hash of the source content, the asset settings,
+   * the kind of builder, and the identity of the tools used to create it.
+   *
+   * To avoid hashing every source file on each build, the content-hash is only
+   * re-calculated if the timestamp or size of the source changed.
+   * All functions are thread-safe.
+   */
+  class BuildCache
+  {
+    public:
+      struct Entry
+      {
+        uint64_t key{};     // combined hash of everything the output depends on
+        uint64_t srcHash{}; // hash of the source file content
+        uint64_t srcTime{};
+        uint64_t srcSize{};
+      };
+
+    private:
+      fs::path path{};
+      std::unordered_map<std::string, Entry> entries{};
+      std::unordered_map<std::string, Entry> pending{};
+      std::unordered_map<std::string, std::string> toolIds{};
+      std::mutex mtx{};
+      bool dirty{false};
+
+    public:
+      void load(const fs::path &dbPath);
+      void save();
+
+      /**
+       * Checks if an output is up-to-date.
+       * If not, the new state is remembered until 'markBuilt' is called for the same output.
+       *
+       * @param outPath output file
+       * @param srcPath source file
+       * @param buildKey everything besides the source content affecting the output
+       * @return true if the output exists and was built from the same inputs
+       */
+      bool isUpToDate(const fs::path &outPath, const fs::path &srcPath, const std::string &buildKey);
+
+      /**
+       * Commits the state of a successful build that was checked with 'isUpToDate' before.
+       * @param outPath output file
+       */
+      void markBuilt(const fs::path &outPath);
+
+      /**
+       * Returns a string identifying the version of an external tool (path, size, timestamp).
+       * Results are cached for the lifetime of this object.
+       */
+      const std::string &getToolId(const fs::path &toolPath);
+  };
+}
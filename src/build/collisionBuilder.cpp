@@ -3,6 +3,7 @@
 * @license MIT
 */
 #include "projectBuilder.h"
+#include <cmath>
 #include "../utils/binaryFile.h"
 #include "../utils/fs.h"
 #include "../project/assets/collision.h"
@@ -56,26 +57,11 @@ namespace
   }
 
   void convert(
-    const char* gltfPath, Utils::BinaryFile &file, float baseScale,
-    const std::unordered_set<std::string> &meshes
+    const cgltf_data* data, Utils::BinaryFile &file, float baseScale,
+    bool withEdgeNormals, const std::unordered_set<std::string> &meshes
   )
   {
-    cgltf_options options{};
-    cgltf_data* data = nullptr;
-    cgltf_result result = cgltf_parse_file(&options, gltfPath, &data);
-
-    if(result == cgltf_result_file_not_found) {
-      throw std::runtime_error("File not found!");
-    }
-    if(cgltf_validate(data) != cgltf_result_success) {
-      throw std::runtime_error("Invalid glTF data!");
-    }
-
-    cgltf_load_buffers(&options, data, gltfPath);
-
-    std::vector<Vec3> verticesFloat{};
-    std::vector<glm::i16vec3> vertices{};
-    std::vector<glm::i16vec3> normals{};
+    std::vector<glm::vec3> verticesFloat{};
     std::vector<uint16_t> indices{};
 
     for(int i=0; i<data->nodes_count; ++i)
@@ -97,7 +83,7 @@ namespace
 
       for(int j = 0; j < mesh->primitives_count; j++)
       {
-        int baseIndex = vertices.size();
+        int baseIndex = verticesFloat.size();
         assert(baseIndex < 0x10000);
 
         auto prim = &mesh->primitives[j];
@@ -132,11 +118,6 @@ namespace
                 vert[1] * baseScale,
                 vert[2] * baseScale
               });
-              vertices.push_back({
-                (int16_t)(vert[0] * baseScale),
-                (int16_t)(vert[1] * baseScale),
-                (int16_t)(vert[2] * baseScale)
-              });
               basePtr += Gltf::getDataSize(acc->component_type) * 3;
             }
           }
@@ -145,75 +126,23 @@ namespace
       } // primitives
     } // nodes
 
-    // generate normals
-    for(int v=0; v<indices.size(); v+=3) {
-      Vec3 edge1 = verticesFloat[indices[v+1]] - verticesFloat[indices[v]];
-      Vec3 edge2 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
-      Vec3 edge3 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
-
-      if(edge1.length() < 0.01f || edge2.length() < 0.01f || edge3.length() < 0.01f) {
-        printf("Degenerate triangle:\nA: %.4f %.4f %.4f\nB: %.4f %.4f %.4f\nC: %.4f %.4f %.4f\n",
-          verticesFloat[indices[v]][0], verticesFloat[indices[v]][1], verticesFloat[indices[v]][2],
-          verticesFloat[indices[v+1]][0], verticesFloat[indices[v+1]][1], verticesFloat[indices[v+1]][2],
-          verticesFloat[indices[v+2]][0], verticesFloat[indices[v+2]][1], verticesFloat[indices[v+2]][2]
-        );
-        printf("Indices: %d %d %d\n", indices[v], indices[v+1], indices[v+2]);
-        throw std::runtime_error("Degenerate triangle!");
-      }
-
-      Vec3 normal = edge1.cross(edge2);
-      normal = normal * (1.0f / normal.length());
-      normals.push_back({
-        (int16_t)(normal[0] * 32767.0f),
-        (int16_t)(normal[1] * 32767.0f),
-        (int16_t)(normal[2] * 32767.0f)
-      });
-    }
-
-    assert(indices.size() % 3 == 0);
-
-    // printf("Vert/Index count: %lu %lu\n", vertices.size(), indices.size());
-
-    auto bvh = Project::Assets::Collision::createBVH(vertices, indices);
-
-    file.write<uint32_t>(indices.size() / 3);
-    file.write<uint32_t>(vertices.size());
-    file.write<float>(1.0f);// / baseScale);
-    file.write<uint32_t>(0); // vertex pointer
-    file.write<uint32_t>(0); // normals pointer
-    file.write<uint32_t>(0); // BVH pointer
-
-    file.writeArray(indices.data(), indices.size());
-    file.align(4);
-
-    for(auto& n : normals) {
-      file.write(n.x);
-      file.write(n.y);
-      file.write(n.z);
-    }
-    file.align(4);
-
-    for(auto& v : verticesFloat) {
-      file.writeArray(v.data, 3);
-    }
-    file.align(4);
-
-    file.writeArray(bvh.data(), bvh.size());
-    file.writeArray(bvh.data(), bvh.size());
-    file.align(4);
+    Project::Assets::Collision::writeMesh(file, verticesFloat, indices, withEdgeNormals);
   }
 }
 
 namespace Build
 {
   Utils::BinaryFile buildCollision(
+    GltfCache &gltfCache,
     const std::string &gltfPath,
     float baseScale,
+    bool edgeNormals,
     const std::unordered_set<std::string> &meshes
   )
   {
+    auto data = gltfCache.get(gltfPath);
     Utils::BinaryFile f{};
-    convert(gltfPath.c_str(), f, baseScale, meshes);
+    convert(data.get(), f, baseScale, edgeNormals, meshes);
     return f;
   }
 }
\ No newline at end of file
@@ -29,26 +29,34 @@ bool Build::buildFontAssets(Project::Project &project, SceneCtx &sceneCtx)
       sceneCtx.autoLoadFontUUIDs[fontId] = font.getUUID();
     }
 
-    if(!assetBuildNeeded(font, outPath))continue;
-
-    int compr = (int)font.conf.compression - 1;
-    if(compr < 0)compr = 1; // @TODO: pull default compression level
-
-    fs::path charsetFile{};
-    if(!font.conf.fontCharset.value.empty()) {
-      charsetFile = outDir / (font.name + "_charset.txt");
-      Utils::FS::saveTextFile(charsetFile, font.conf.fontCharset.value);
-    }
-
-    std::string cmd = mkFont.string() + " -c " + std::to_string(compr);
-    cmd += " -o \"" + outDir.string() + "\"";
-    cmd += " -s " + std::to_string(font.conf.baseScale);
-    if(!charsetFile.empty())cmd += " --charset \"" + charsetFile.string() + "\"";
-    cmd += " \"" + font.path + "\"";
-
-    bool res = sceneCtx.toolchain.runCmdSyncLogged(cmd);
-    fs::remove(charsetFile);
-    if(!res)return false;
+    auto toolId = sceneCtx.buildCache.getToolId(mkFont);
+
+    sceneCtx.jobs.add(font.path, [&sceneCtx, &font, mkFont, outPath, outDir, toolId]()
+    {
+      if(!assetBuildNeeded(sceneCtx, font, outPath, toolId))return true;
+
+      int compr = (int)font.conf.compression - 1;
+      if(compr < 0)compr = 1; // @TODO: pull default compression level
+
+      fs::path charsetFile{};
+      if(!font.conf.fontCharset.value.empty()) {
+        charsetFile = outDir / (font.name + "_charset.txt");
+        Utils::FS::saveTextFile(charsetFile, font.conf.fontCharset.value);
+      }
+
+      std::string cmd = mkFont.string() + " -c " + std::to_string(compr);
+      cmd += " -o \"" + outDir.string() + "\"";
+      cmd += " -s " + std::to_string(font.conf.baseScale);
+      if(!charsetFile.empty())cmd += " --charset \"" + charsetFile.string() + "\"";
+      cmd += " \"" + font.path + "\"";
+
+      bool res = sceneCtx.toolchain.runCmdSyncLogged(cmd);
+      fs::remove(charsetFile);
+      if(!res)return false;
+
+      assetBuildDone(sceneCtx, outPath);
+      return true;
+    });
   }
   return true;
 }
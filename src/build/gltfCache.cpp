@@ -0,0 +1,71 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "gltfCache.h"
+
+#include <stdexcept>
+#include "tiny3d/tools/gltf_importer/src/lib/cgltf.h"
+
+namespace
+{
+  Build::GltfCache::Data parseFile(const std::string &path)
+  {
+    cgltf_options options{};
+    cgltf_data* data = nullptr;
+    cgltf_result result = cgltf_parse_file(&options, path.c_str(), &data);
+
+    if(result == cgltf_result_file_not_found) {
+      throw std::runtime_error("File not found: " + path);
+    }
+    if(result != cgltf_result_success) {
+      throw std::runtime_error("Failed to parse glTF: " + path);
+    }
+
+    Build::GltfCache::Data res{data, [](const cgltf_data *d) {
+      cgltf_free(const_cast<cgltf_data*>(d));
+    }};
+
+    if(cgltf_validate(data) != cgltf_result_success) {
+      throw std::runtime_error("Invalid glTF data: " + path);
+    }
+    if(cgltf_load_buffers(&options, data, path.c_str()) != cgltf_result_success) {
+      throw std::runtime_error("Failed to load glTF buffers: " + path);
+    }
+    return res;
+  }
+}
+
+Build::GltfCache::Data Build::GltfCache::get(const std::string &path)
+{
+  std::promise<Data> promise{};
+  std::shared_future<Data> future{};
+  bool isOwner = false;
+  {
+    std::lock_guard lock{mtx};
+    auto it = entries.find(path);
+    if(it == entries.end()) {
+      future = promise.get_future().share();
+      entries.emplace(path, future);
+      isOwner = true;
+    } else {
+      future = it->second;
+    }
+  }
+
+  // parse outside the lock, other files can be requested in the meantime
+  if(isOwner) {
+    try {
+      promise.set_value(parseFile(path));
+    } catch(...) {
+      promise.set_exception(std::current_exception());
+    }
+  }
+  return future.get();
+}
+
+void Build::GltfCache::clear()
+{
+  std::lock_guard lock{mtx};
+  entries.clear();
+}
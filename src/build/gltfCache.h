@@ -0,0 +1,40 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct cgltf_data;
+
+namespace Build
+{
+  /**
+   * Per-build cache of parsed glTF files (including their loaded buffers), keyed by path.
+   * Lets all collision variants of a model (embedded chunk and per-scene subsets) share a single parse.
+   * Note that 'T3DM::parseGLTF' (tiny3d) only takes a path and always parses the file again on its own.
+   * Thread-safe, a file requested by multiple jobs at once is still only parsed once.
+   */
+  class GltfCache
+  {
+    public:
+      using Data = std::shared_ptr<const cgltf_data>;
+
+      /**
+       * Returns the parsed file, parsing it on first use.
+       * Throws if the file could not be loaded or is invalid.
+       */
+      Data get(const std::string &path);
+
+      // releases all files not in use anymore
+      void clear();
+
+    private:
+      std::mutex mtx{};
+      std::unordered_map<std::string, std::shared_future<Data>> entries{};
+  };
+}
@@ -0,0 +1,105 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "jobGraph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "../utils/logger.h"
+
+Build::JobGraph::JobId Build::JobGraph::add(const std::string &name, JobFunc func, const std::vector<JobId> &deps)
+{
+  JobId id = jobs.size();
+  jobs.push_back({
+    .name = name,
+    .func = std::move(func),
+    .depCount = (uint32_t)deps.size(),
+  });
+
+  for(auto dep : deps) {
+    jobs[dep].dependents.push_back(id);
+  }
+  return id;
+}
+
+bool Build::JobGraph::run(uint32_t threadCount)
+{
+  if(jobs.empty())return true;
+
+  if(threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  threadCount = std::min<uint32_t>(threadCount, jobs.size());
+
+  std::mutex mtx{};
+  std::condition_variable cv{};
+  std::deque<JobId> ready{};
+  uint32_t jobsLeft = jobs.size();
+  uint32_t jobsRunning = 0;
+  bool failed = false;
+
+  for(JobId id=0; id<jobs.size(); ++id) {
+    if(jobs[id].depCount == 0)ready.push_back(id);
+  }
+
+  auto worker = [&]()
+  {
+    std::unique_lock lock{mtx};
+    for(;;)
+    {
+      cv.wait(lock, [&] {
+        return !ready.empty() || jobsLeft == 0 || (failed && jobsRunning == 0);
+      });
+
+      // once something failed, finish running jobs but don't start new ones
+      if(jobsLeft == 0 || failed)return;
+
+      JobId id = ready.front();
+      ready.pop_front();
+      ++jobsRunning;
+      lock.unlock();
+
+      auto &job = jobs[id];
+      bool success = false;
+
+      Utils::Logger::beginGroup();
+      try {
+        success = job.func();
+      } catch(const std::exception &e) {
+        Utils::Logger::log("Job '" + job.name + "' failed: " + e.what(), Utils::Logger::LEVEL_ERROR);
+      }
+      Utils::Logger::endGroup();
+
+      lock.lock();
+      --jobsRunning;
+      --jobsLeft;
+
+      if(success) {
+        for(auto dep : job.dependents) {
+          if(--jobs[dep].depCount == 0)ready.push_back(dep);
+        }
+      } else {
+        Utils::Logger::log("Asset build failed: " + job.name, Utils::Logger::LEVEL_ERROR);
+        failed = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  threads.reserve(threadCount-1);
+  for(uint32_t i=1; i<threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker(); // calling thread helps out too
+
+  for(auto &t : threads)t.join();
+
+  jobs.clear();
+  return !failed;
+}
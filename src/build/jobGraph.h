@@ -0,0 +1,62 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Build
+{
+  /**
+   * Dependency graph of build jobs (usually one per asset).
+   * Jobs are collected first, and then executed by a bounded pool of worker threads.
+   * A job only starts once all of its dependencies have finished successfully.
+   *
+   * Log output of a job is buffered and written out in one piece after it finished,
+   * so that output from different assets does not get interleaved.
+   */
+  class JobGraph
+  {
+    public:
+      using JobId = uint32_t;
+      using JobFunc = std::function<bool()>;
+
+    private:
+      struct Job
+      {
+        std::string name{};
+        JobFunc func{};
+        std::vector<JobId> dependents{};
+        uint32_t depCount{0};
+      };
+
+      std::vector<Job> jobs{};
+
+    public:
+      /**
+       * Adds a new job, this will not execute anything yet.
+       * @param name name used for logging (e.g. the asset path)
+       * @param func job to run, returns false on failure
+       * @param deps jobs that must be done before this one can start
+       * @return ID of the new job, can be used as a dependency for later jobs
+       */
+      JobId add(const std::string &name, JobFunc func, const std::vector<JobId> &deps = {});
+
+      /**
+       * Runs all jobs and blocks until they are done.
+       * If any job fails, no new jobs are started and the function returns false
+       * once all currently running jobs have finished.
+       * All jobs are removed afterward.
+       *
+       * @param threadCount max. number of worker threads, 0 to use the number of CPU cores
+       * @return true if all jobs succeeded
+       */
+      bool run(uint32_t threadCount = 0);
+
+      [[nodiscard]] bool empty() const { return jobs.empty(); }
+      [[nodiscard]] size_t size() const { return jobs.size(); }
+  };
+}
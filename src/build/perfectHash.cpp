@@ -0,0 +1,130 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "perfectHash.h"
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+#include "../../n64/engine/include/lib/perfectHash.h"
+
+namespace
+{
+  constexpr int32_t MAX_SEED = 0x7FFF'FFFF;
+}
+
+std::vector<std::string> Build::PerfectHash::removeDuplicates(std::vector<std::string> &keys, std::vector<uint32_t> &values)
+{
+  std::vector<std::string> removed{};
+  std::unordered_set<std::string> seen{};
+  uint32_t count = 0;
+  for(uint32_t i=0; i<keys.size(); ++i) {
+    if(!seen.insert(keys[i]).second) {
+      removed.push_back(std::move(keys[i]));
+      continue;
+    }
+    if(count != i) {
+      keys[count] = std::move(keys[i]);
+      values[count] = values[i];
+    }
+    ++count;
+  }
+  keys.resize(count);
+  values.resize(count);
+  return removed;
+}
+
+Build::PerfectHash::Table Build::PerfectHash::create(const std::vector<std::string> &keys)
+{
+  using P64::PerfectHash::hash;
+  uint32_t count = keys.size();
+
+  Table res{};
+  res.seeds.resize(count, 0);
+  res.slots.resize(count, P64::PerfectHash::NOT_FOUND);
+  if(count == 0)return res;
+
+  std::vector<std::vector<uint32_t>> buckets(count);
+  for(uint32_t i=0; i<count; ++i) {
+    buckets[hash(0, keys[i]) % count].push_back(i);
+  }
+
+  // place the largest buckets first, while most slots are still free
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  std::vector<uint32_t> bucketSlots{};
+  uint32_t nextFreeSlot = 0;
+
+  for(auto b : order)
+  {
+    auto &bucket = buckets[b];
+    if(bucket.empty())break;
+
+    // buckets with a single key don't need a search, they go into any free slot
+    if(bucket.size() == 1) {
+      while(res.slots[nextFreeSlot] != P64::PerfectHash::NOT_FOUND)++nextFreeSlot;
+      res.slots[nextFreeSlot] = bucket[0];
+      res.seeds[b] = -(int32_t)nextFreeSlot - 1;
+      continue;
+    }
+
+    for(int32_t seed = 1;; ++seed)
+    {
+      if(seed == MAX_SEED) {
+        throw std::runtime_error("Perfect hash: no seed found (duplicate keys?)");
+      }
+
+      bucketSlots.clear();
+      bool valid = true;
+      for(auto keyIdx : bucket) {
+        uint32_t slot = hash(seed, keys[keyIdx]) % count;
+        if(res.slots[slot] != P64::PerfectHash::NOT_FOUND
+          || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end()) {
+          valid = false;
+          break;
+        }
+        bucketSlots.push_back(slot);
+      }
+      if(!valid)continue;
+
+      for(uint32_t i=0; i<bucket.size(); ++i) {
+        res.slots[bucketSlots[i]] = bucket[i];
+      }
+      res.seeds[b] = seed;
+      break;
+    }
+  }
+  return res;
+}
+
+std::string Build::PerfectHash::toCode(
+  const std::string &prefix, const std::vector<std::string> &keys,
+  const std::vector<uint32_t> &values
+)
+{
+  auto table = create(keys);
+  auto count = keys.size();
+
+  std::string strSeeds{};
+  std::string strKeys{};
+  std::string strValues{};
+  for(uint32_t i=0; i<count; ++i) {
+    strSeeds += std::to_string(table.seeds[i]) + ",";
+    strKeys += "\"" + keys[table.slots[i]] + "\",";
+    strValues += std::to_string(values[table.slots[i]]) + ",";
+  }
+
+  return std::format(
+    "constexpr std::array<int32_t, {0}> {1}_SEEDS{{{2}}};\n"
+    "constexpr std::array<std::string_view, {0}> {1}_KEYS{{{3}}};\n"
+    "constexpr std::array<uint32_t, {0}> {1}_VALUES{{{4}}};\n",
+    count, prefix, strSeeds, strKeys, strValues
+  );
+}
@@ -0,0 +1,39 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Build::PerfectHash
+{
+  struct Table
+  {
+    std::vector<int32_t> seeds{};  // per bucket, see 'P64::PerfectHash::find'
+    std::vector<uint32_t> slots{}; // index into the input keys for each slot
+  };
+
+  /**
+   * Removes keys that appeared before (together with their value), since 'create' needs unique keys.
+   * The first one is kept, which is the one a linear search would have found.
+   * @return removed keys, in the order they were found
+   */
+  std::vector<std::string> removeDuplicates(std::vector<std::string> &keys, std::vector<uint32_t> &values);
+
+  /**
+   * Creates a minimal perfect hash for a set of unique keys.
+   * The result is meant to be emitted as code and resolved with 'P64::PerfectHash::find'.
+   */
+  Table create(const std::vector<std::string> &keys);
+
+  /**
+   * Generates the constexpr arrays of a table, to be placed into a generated header.
+   * Declares '<prefix>_SEEDS', '<prefix>_KEYS' and '<prefix>_VALUES'.
+   */
+  std::string toCode(
+    const std::string &prefix, const std::vector<std::string> &keys,
+    const std::vector<uint32_t> &values
+  );
+}
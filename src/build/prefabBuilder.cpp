@@ -5,8 +5,10 @@
 #include "projectBuilder.h"
 #include "../utils/string.h"
 #include "../utils/fs.h"
+#include "../utils/hash.h"
 #include "../utils/logger.h"
 #include "../utils/proc.h"
+#include <algorithm>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -15,6 +17,25 @@ bool Build::buildPrefabAssets(Project::Project &project, SceneCtx &sceneCtx)
 {
   fs::path mkAsset = fs::path{project.conf.pathN64Inst} / "bin" / "mkasset";
   auto &assets = sceneCtx.project->getAssets().getTypeEntries(Project::FileType::PREFAB);
+
+  // prefabs are written through the shared scene-context (object file, string-table),
+  // so each job waits for the previous one instead of running in parallel
+  std::vector<JobGraph::JobId> lastJob{};
+
+  // prefabs reference other assets and scripts by index, so any change there affects the output too
+  std::string depKey{};
+  for(auto &entry : sceneCtx.assetList) {
+    depKey += entry.path + ";";
+  }
+  std::vector<std::pair<uint64_t, uint32_t>> codeIdx{sceneCtx.codeIdxMapUUID.begin(), sceneCtx.codeIdxMapUUID.end()};
+  std::sort(codeIdx.begin(), codeIdx.end());
+  for(auto &[uuid, idx] : codeIdx) {
+    depKey += Utils::toHex64(uuid) + "=" + std::to_string(idx) + ";";
+  }
+  depKey = Utils::toHex64(Utils::Hash::sha256_64bit(depKey));
+
+  auto toolId = sceneCtx.buildCache.getToolId(Utils::Proc::getSelfPath());
+
   for (auto &asset : assets)
   {
     if(asset.conf.exclude)continue;
@@ -25,14 +46,22 @@ bool Build::buildPrefabAssets(Project::Project &project, SceneCtx &sceneCtx)
     fs::create_directories(outPath.parent_path());
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(asset.outPath));
-    if(!assetBuildNeeded(asset, outPath))continue;
 
-    //printf("Prefab: %s -> %s\n", asset.path.c_str(), outPath.string().c_str());
+    auto jobId = sceneCtx.jobs.add(asset.path, [&sceneCtx, &asset, outPath, toolId, depKey]()
+    {
+      if(!assetBuildNeeded(sceneCtx, asset, outPath, toolId, depKey))return true;
+
+      //printf("Prefab: %s -> %s\n", asset.path.c_str(), outPath.string().c_str());
+
+      sceneCtx.fileObj = {};
+      writeObject(sceneCtx, asset.prefab->obj, true);
+      sceneCtx.fileObj.writeToFile(outPath);
+      sceneCtx.fileObj = {};
 
-    sceneCtx.fileObj = {};
-    writeObject(sceneCtx, asset.prefab->obj, true);
-    sceneCtx.fileObj.writeToFile(outPath);
-    sceneCtx.fileObj = {};
+      assetBuildDone(sceneCtx, outPath);
+      return true;
+    }, lastJob);
+    lastJob = {jobId};
   }
   return true;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 * @license MIT
 */
 #include "projectBuilder.h"
+#include "perfectHash.h"
 
 #include <filesystem>
 #include <thread>
@@ -30,6 +31,15 @@ namespace
     {Build::buildAudioAssets,   "Audio"},
     {Build::buildPrefabAssets,  "Prefab"},
   });
+
+  // lookups by name need unique names, for duplicates only the first entry can be found
+  void removeDuplicateNames(const std::string &type, std::vector<std::string> &names, std::vector<uint32_t> &values)
+  {
+    for(auto &name : Build::PerfectHash::removeDuplicates(names, values)) {
+      Utils::Logger::log("Duplicate " + type + " name '" + name + "', only the first one can be looked up by name",
+        Utils::Logger::LEVEL_WARN);
+    }
+  }
 }
 
 void Build::SceneCtx::addAsset(const Project::AssetManagerEntry &entry)
@@ -37,7 +47,8 @@ void Build::SceneCtx::addAsset(const Project::AssetManagerEntry &entry)
   assetUUIDToIdx[entry.getUUID()] = assetList.size();
   if(entry.romPath.size() > 5) {
     auto outNameNoPrefix = entry.romPath.substr(5); // remove "rom:/"
-    assetFileMap += "if(path == \"" + outNameNoPrefix + "\")return " + std::to_string(assetList.size()) + ";\n";
+    assetFileNames.push_back(outNameNoPrefix);
+    assetFileIndices.push_back(assetList.size());
   }
 
   uint32_t flags = 0;
@@ -45,8 +56,7 @@ void Build::SceneCtx::addAsset(const Project::AssetManagerEntry &entry)
     flags |= 0x01; // KEEP_LOADED
   }
 
-  assetList.push_back({entry.romPath, stringOffset, (uint32_t)entry.type, flags});
-  stringOffset += entry.romPath.size() + 1;
+  assetList.push_back({entry.romPath, strTable.add(entry.romPath), (uint32_t)entry.type, flags});
 }
 
 bool Build::buildProject(const std::string &configPath)
@@ -94,6 +104,7 @@ bool Build::buildProject(const std::string &configPath)
   SceneCtx sceneCtx{};
   sceneCtx.toolchain.scan();
   sceneCtx.project = &project;
+  sceneCtx.buildCache.load(fs::absolute(fs::path{path} / "build" / "assetCache.json"));
 
   // Global project config
   sceneCtx.files.push_back("filesystem/p64/conf");
@@ -126,10 +137,12 @@ bool Build::buildProject(const std::string &configPath)
   project.getScenes().reload();
   const auto &scenes = project.getScenes().getEntries();
 
-  std::string sceneMapStr{};
+  std::vector<std::string> sceneNames{};
+  std::vector<uint32_t> sceneIds{};
   std::string sceneNameStr{};
   for (const auto &scene : scenes) {
-    sceneMapStr += "if(path == \"" + scene.name + "\")return " + std::to_string(scene.id) + ";\n";
+    sceneNames.push_back(scene.name);
+    sceneIds.push_back(scene.id);
     sceneNameStr += "\"" + scene.name + "\",\n";
     try
     {
@@ -141,8 +154,9 @@ bool Build::buildProject(const std::string &configPath)
     }
   }
 
+  removeDuplicateNames("scene", sceneNames, sceneIds);
   auto sceneTableHeader = Utils::replaceAll(Utils::FS::loadTextFile("data/scripts/sceneTable.h"), {
-    {"{{SCENE_MAP}}", sceneMapStr},
+    {"{{SCENE_MAP}}", PerfectHash::toCode("SCENE", sceneNames, sceneIds)},
     {"{{SCENE_COUNT}}", std::to_string(scenes.size())}
   });
   Utils::FS::saveTextFile(project.getPath() + "/src/p64/sceneTable.h", sceneTableHeader);
@@ -156,6 +170,7 @@ bool Build::buildProject(const std::string &configPath)
   );
 
 
+  // collect conversion jobs of all assets first, then run them in parallel
   for(auto &builder : assetBuilders)
   {
     if(!builder.func(project, sceneCtx)) {
@@ -164,25 +179,33 @@ bool Build::buildProject(const std::string &configPath)
     }
   }
 
+  bool jobsOk = sceneCtx.jobs.run();
+  sceneCtx.gltfCache.clear();
+  if(!jobsOk) {
+    sceneCtx.buildCache.save();
+    return false;
+  }
+
+  removeDuplicateNames("asset", sceneCtx.assetFileNames, sceneCtx.assetFileIndices);
   auto assetTableCode = Utils::replaceAll(
     Utils::FS::loadTextFile("data/scripts/assetTable.h"),
-    "{{ASSET_MAP}}", sceneCtx.assetFileMap
+    "{{ASSET_MAP}}", PerfectHash::toCode("ASSET", sceneCtx.assetFileNames, sceneCtx.assetFileIndices)
   );
   Utils::FS::saveTextFile(project.getPath() + "/src/p64/assetTable.h", assetTableCode);
 
-  // Asset table
+  // Asset table, paths are deduplicated and tail-merged in the string table after it
+  sceneCtx.strTable.build();
   Utils::BinaryFile fileList{};
   fileList.write<uint32_t>(sceneCtx.assetList.size());
   uint32_t baseOffset = (sceneCtx.assetList.size() * sizeof(uint32_t)*2) + sizeof(uint32_t);
   for (auto &entry : sceneCtx.assetList) {
-    fileList.write(baseOffset + entry.stringOffset);
+    fileList.write(baseOffset + sceneCtx.strTable.getOffset(entry.pathId));
     uint32_t ptr = entry.type << (32-4);
     ptr |= entry.flags << (32-8);
     fileList.write(ptr);
   }
-  for (auto &entry : sceneCtx.assetList) {
-    fileList.writeChars(entry.path.c_str(), entry.path.size()+1);
-  }
+  auto &strTable = sceneCtx.strTable.getTable();
+  fileList.writeChars(strTable.c_str(), strTable.size());
   fileList.writeToFile(fsDataPath / "a");
 
   // kep order stable to detect makefile changes
@@ -211,6 +234,9 @@ bool Build::buildProject(const std::string &configPath)
     sceneCtx.toolchain.runCmdSyncLogged("make -C \"" + path + "\" cleanCode");
   }
 
+  // saved after the clean above, which wipes the build directory
+  sceneCtx.buildCache.save();
+
   {
     Utils::BinaryFile f{};
     f.write<uint32_t>(project.conf.sceneIdOnBoot);
@@ -234,14 +260,25 @@ bool Build::buildProject(const std::string &configPath)
 }
 
 
-bool Build::assetBuildNeeded(const Project::AssetManagerEntry &asset, const fs::path &outPath)
+bool Build::assetBuildNeeded(
+  SceneCtx &ctx, const Project::AssetManagerEntry &asset, const fs::path &outPath,
+  const std::string &toolId, const std::string &extraKey
+)
 {
-  auto ageSrc = Utils::FS::getFileAge(asset.path);
-  auto ageDst = Utils::FS::getFileAge(outPath);
-  if(ageSrc < ageDst) {
+  auto buildKey = std::to_string((int)asset.type)
+    + "|" + asset.conf.serialize()
+    + "|" + toolId
+    + "|" + extraKey;
+
+  if(ctx.buildCache.isUpToDate(outPath, asset.path, buildKey)) {
     //Utils::Logger::log("Skipping Asset (up to date): " + asset.outPath);
     return false;
   }
   Utils::Logger::log("Building Asset: " + asset.path);
   return true;
 }
+
+void Build::assetBuildDone(SceneCtx &ctx, const fs::path &outPath)
+{
+  ctx.buildCache.markBuilt(outPath);
+}
@@ -12,7 +12,22 @@ namespace Build
   typedef bool(*BuildFunc)(Project::Project &project, SceneCtx &sceneCtx);
 
   // helper
-  bool assetBuildNeeded(const Project::AssetManagerEntry &asset, const fs::path &outPath);
+  /**
+   * Checks the build-cache if an asset needs to be (re-)built.
+   * After a successful build, 'assetBuildDone' must be called with the same output path.
+   *
+   * @param ctx scene context
+   * @param asset asset to build
+   * @param outPath output file
+   * @param toolId identity of the tool(s) used, see 'BuildCache::getToolId'
+   * @param extraKey additional inputs affecting the output (optional)
+   * @return true if a build is needed
+   */
+  bool assetBuildNeeded(
+    SceneCtx &ctx, const Project::AssetManagerEntry &asset, const fs::path &outPath,
+    const std::string &toolId, const std::string &extraKey = {}
+  );
+  void assetBuildDone(SceneCtx &ctx, const fs::path &outPath);
 
   // Asset builds
   void buildScene(Project::Project &project, const Project::SceneEntry &scene, SceneCtx &ctx);
@@ -38,5 +53,13 @@ namespace Build
     uint64_t newUUID
   );
 
-  Utils::BinaryFile buildCollision(const std::string &gltfPath, float baseScale, const std::unordered_set<std::string> &meshes = {});
+  /**
+   * Converts (parts of) a glTF into the runtime collision format.
+   * The file is parsed through the given cache, so all collision variants of a model share one parse.
+   * With 'edgeNormals' set, each triangle also stores its edge-planes, which speeds up collision at runtime.
+   */
+  Utils::BinaryFile buildCollision(
+    GltfCache &gltfCache, const std::string &gltfPath, float baseScale, bool edgeNormals,
+    const std::unordered_set<std::string> &meshes = {}
+  );
 }
@@ -4,6 +4,7 @@
 */
 #include "projectBuilder.h"
 #include "../utils/string.h"
+#include <algorithm>
 #include <filesystem>
 
 #include "../utils/binaryFile.h"
@@ -41,6 +42,7 @@ uint32_t Build::writeObject(Build::SceneCtx &ctx, Project::Object &obj, bool sav
 
   ctx.fileObj.write<uint16_t>(objFlags); // @TODO type
   ctx.fileObj.write<uint16_t>(obj.id);
+  ctx.maxObjectId = std::max(ctx.maxObjectId, obj.id);
   ctx.fileObj.write<uint16_t>(obj.parent ? obj.parent->id : 0);
   ctx.fileObj.write<uint16_t>(0); // padding
   ctx.fileObj.write(srcObj->pos.resolve(obj.propOverrides));
@@ -101,6 +103,7 @@ uint32_t Build::writeObject(Build::SceneCtx &ctx, Project::Object &obj, bool sav
 
   ctx.fileObj.write<uint32_t>(0);
 
+  // children always come after their parent, the runtime links them into the hierarchy while loading
   uint32_t count = 1;
   for (const auto &child : obj.children) {
     count += writeObject(ctx, *child, savePrefabItself);
@@ -127,6 +130,7 @@ void Build::buildScene(Project::Project &project, const Project::SceneEntry &sce
   if (sc->conf.fbFormat)sceneFlags |= FLAG_SCR_32BIT;
 
   ctx.fileObj = {};
+  ctx.maxObjectId = 0;
   auto &rootObj = sc->getRootObject();
   for (const auto &child : rootObj.children) {
     objCount += writeObject(ctx, *child, false);
@@ -139,7 +143,8 @@ void Build::buildScene(Project::Project &project, const Project::SceneEntry &sce
   ctx.fileScene.write<uint16_t>(sc->conf.fbHeight);
   ctx.fileScene.write(sceneFlags);
   ctx.fileScene.writeRGBA(sc->conf.clearColor.value);
-  ctx.fileScene.write(objCount);
+  ctx.fileScene.write<uint16_t>(objCount);
+  ctx.fileScene.write<uint16_t>(ctx.maxObjectId);
 
   ctx.fileScene.write<uint8_t>(sc->conf.renderPipeline.value);
   ctx.fileScene.write<uint8_t>(sc->conf.frameLimit.value);
@@ -3,8 +3,12 @@
 * @license MIT
 */
 #pragma once
+#include <mutex>
 #include <vector>
 
+#include "buildCache.h"
+#include "gltfCache.h"
+#include "jobGraph.h"
 #include "stringTable.h"
 #include "../utils/binaryFile.h"
 #include "../utils/toolchain.h"
@@ -16,7 +20,7 @@ namespace Build
   struct AssetEntry
   {
     std::string path{};
-    uint32_t stringOffset{};
+    uint32_t pathId{}; // ID in 'SceneCtx::strTable'
     uint32_t type{};
     uint32_t flags{};
   };
@@ -27,6 +31,7 @@ namespace Build
     Project::Project *project{};
     Project::Scene *scene{};
     std::vector<std::string> files{};
+    std::mutex mtxFiles{};
     std::array<uint64_t, 16> autoLoadFontUUIDs{};
     std::unordered_map<uint64_t, uint32_t> codeIdxMapUUID{};
     Utils::BinaryFile fileScene{};
@@ -36,9 +41,21 @@ namespace Build
 
     std::vector<AssetEntry> assetList{};
     std::unordered_map<uint64_t, uint32_t> assetUUIDToIdx{};
-    std::string assetFileMap{};
-    uint32_t stringOffset{0};
+    std::vector<std::string> assetFileNames{};
+    std::vector<uint32_t> assetFileIndices{};
+    uint16_t maxObjectId{0}; // highest ID written by 'writeObject' for the current scene
+
+    // per-asset conversions, filled by the asset builders and executed at once
+    JobGraph jobs{};
+    BuildCache buildCache{};
+    GltfCache gltfCache{};
 
     void addAsset(const Project::AssetManagerEntry &entry);
+
+    // thread-safe version of 'files.push_back', for use inside of jobs
+    void addFile(const std::string &path) {
+      std::lock_guard lock{mtxFiles};
+      files.push_back(path);
+    }
   };
 }
@@ -0,0 +1,49 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "stringTable.h"
+
+#include <algorithm>
+#include <numeric>
+
+uint32_t Build::StringTable::add(const std::string &str)
+{
+  auto [it, inserted] = ids.try_emplace(str, (uint32_t)strings.size());
+  if(inserted) {
+    strings.push_back(&it->first); // node-based map, key addresses are stable
+  }
+  return it->second;
+}
+
+void Build::StringTable::build()
+{
+  // sort by the reversed string, this puts each string right before all strings ending with it
+  std::vector<uint32_t> order(strings.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    auto &strA = *strings[a];
+    auto &strB = *strings[b];
+    return std::lexicographical_compare(strA.rbegin(), strA.rend(), strB.rbegin(), strB.rend());
+  });
+
+  table.clear();
+  offsets.assign(strings.size(), 0);
+
+  // go from longest to shortest, the previous string is either one we can point into, or none is
+  const std::string *prevStr = nullptr;
+  uint32_t prevOffset = 0;
+  for(auto idx = order.rbegin(); idx != order.rend(); ++idx)
+  {
+    auto &str = *strings[*idx];
+    if(prevStr && prevStr->ends_with(str)) {
+      offsets[*idx] = prevOffset + prevStr->size() - str.size();
+    } else {
+      offsets[*idx] = table.size();
+      table += str;
+      table.push_back('\0');
+    }
+    prevStr = &str;
+    prevOffset = offsets[*idx];
+  }
+}
@@ -5,22 +5,34 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Build
 {
-  struct StringTable
+  /**
+   * Interned, null-terminated string table.
+   * Strings are first collected with 'add', which returns a stable ID.
+   * Calling 'build' then lays out the final table, where strings that are a suffix
+   * of another one share its memory (e.g. "Box" points into "HitBox").
+   */
+  class StringTable
   {
-    std::string table{};
+    private:
+      std::unordered_map<std::string, uint32_t> ids{};
+      std::vector<const std::string*> strings{};
+      std::vector<uint32_t> offsets{};
+      std::string table{};
 
-    uint32_t insert(const std::string &newString)
-    {
-      auto strPos = table.find(newString);
-      if(strPos == std::string::npos) {
-        strPos = table.size();
-        table += newString;
-        table.push_back('\0');
-      }
-      return strPos;
-    }
+    public:
+      // adds a string (if not already present), returns its ID
+      uint32_t add(const std::string &str);
+
+      // creates the packed table, must be called before reading any offsets
+      void build();
+
+      uint32_t getOffset(uint32_t id) const { return offsets[id]; }
+      const std::string &getTable() const { return table; }
+      uint32_t getCount() const { return strings.size(); }
   };
 }
@@ -10,7 +10,7 @@
 #include "../utils/fs.h"
 #include "../utils/logger.h"
 #include "../utils/proc.h"
-#include "tiny3d/tools/gltf_importer/src/parser.h"
+#include "../project/assets/gltfImport.h"
 
 namespace fs = std::filesystem;
 
@@ -43,7 +43,9 @@ bool Build::buildT3DCollision(
   printf("Building T3DM Collision: %s\n", outPath.string().c_str());
   //printf(" asset: %d | %d\n", sceneCtx.files.size(), sceneCtx.assetUUIDToIdx.size());
 
-  auto collData = Build::buildCollision(model->path, model->conf.baseScale, meshes);
+  auto collData = Build::buildCollision(
+    sceneCtx.gltfCache, model->path, model->conf.baseScale, model->conf.gltfCollEdges.value, meshes
+  );
   collData.writeToFile(outPath.string());
 
   fs::path mkAsset = fs::path{project.conf.pathN64Inst} / "bin" / "mkasset";
@@ -65,66 +67,82 @@ bool Build::buildT3DMAssets(Project::Project &project, SceneCtx &sceneCtx)
   fs::path mkAsset = fs::path{project.conf.pathN64Inst} / "bin" / "mkasset";
   auto &models = sceneCtx.project->getAssets().getTypeEntries(Project::FileType::MODEL_3D);
   auto projectPath = fs::path{project.getPath()};
+  auto assetPathFull = fs::absolute(project.getPath() + "/assets").string();
+
+  // model conversion runs inside the editor itself, followed by mkasset
+  auto toolId = sceneCtx.buildCache.getToolId(Utils::Proc::getSelfPath())
+    + "|" + sceneCtx.buildCache.getToolId(mkAsset);
 
   for (auto &model : models)
   {
     auto t3dmPath = projectPath / model.outPath;
     auto t3dmDir = t3dmPath.parent_path();
+    fs::create_directories(t3dmDir);
 
     sceneCtx.files.push_back(Utils::FS::toUnixPath(model.outPath));
 
-    if(assetBuildNeeded(model, t3dmPath)) {
-      fs::create_directories(t3dmDir);
+    sceneCtx.jobs.add(model.path, [&sceneCtx, &model, mkAsset, projectPath, assetPathFull, t3dmPath, t3dmDir, toolId]()
+    {
+      if(assetBuildNeeded(sceneCtx, model, t3dmPath, toolId))
+      {
+        {
+          // the importer is configured through a global, only one model can be parsed at a time
+          Project::Assets::GLTF::ImportLock importLock{{
+            .globalScale = (float)model.conf.baseScale,
+            .animSampleRate = 60,
+            //.ignoreMaterials = args.checkArg("--ignore-materials"),
+            //.ignoreTransforms = args.checkArg("--ignore-transforms"),
+            .createBVH = model.conf.gltfBVH,
+            .verbose = false,
+            .assetPath = "assets/",
+            .assetPathFull = assetPathFull,
+          }};
+
+          // tiny3d parses by path, this is separate from the parse the collision below shares through the cache
+          auto t3dm = T3DM::parseGLTF(model.path.c_str());
+
+          std::vector<T3DM::CustomChunk> customChunks{};
+
+          if(model.conf.gltfCollision.value) {
+            customChunks.emplace_back('0', buildCollision(
+              sceneCtx.gltfCache, model.path, T3DM::config.globalScale, model.conf.gltfCollEdges.value
+            ).getData());
+          }
 
-      T3DM::config = {
-        .globalScale = (float)model.conf.baseScale,
-        .animSampleRate = 60,
-        //.ignoreMaterials = args.checkArg("--ignore-materials"),
-        //.ignoreTransforms = args.checkArg("--ignore-transforms"),
-        .createBVH = model.conf.gltfBVH,
-        .verbose = false,
-        .assetPath = "assets/",
-        .assetPathFull = fs::absolute(project.getPath() + "/assets").string(),
-      };
+          T3DM::writeT3DM(t3dm, t3dmPath.string().c_str(), projectPath, customChunks);
+        }
 
-      auto t3dm = T3DM::parseGLTF(model.path.c_str());
+        int compr = (int)model.conf.compression - 1;
+        if(compr < 0)compr = 1; // @TODO: pull default compression level
 
-      std::vector<T3DM::CustomChunk> customChunks{};
+        std::string cmd = mkAsset.string() + " -c " + std::to_string(compr);
+        cmd += " -o \"" + t3dmDir.string() + "\"";
+        cmd += " \"" + t3dmPath.string() + "\"";
 
-      if(model.conf.gltfCollision.value) {
-        customChunks.emplace_back('0', buildCollision(model.path, T3DM::config.globalScale).getData());
+        if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
+          return false;
+        }
+        assetBuildDone(sceneCtx, t3dmPath);
       }
 
-      T3DM::writeT3DM(t3dm, t3dmPath.string().c_str(), projectPath, customChunks);
-
-      int compr = (int)model.conf.compression - 1;
-      if(compr < 0)compr = 1; // @TODO: pull default compression level
-
-      std::string cmd = mkAsset.string() + " -c " + std::to_string(compr);
-      cmd += " -o \"" + t3dmDir.string() + "\"";
-      cmd += " \"" + t3dmPath.string() + "\"";
-
-      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-        return false;
-      }
-    }
-
-    // search for all files containing *.sdata
-    for (const auto &entry : fs::directory_iterator{t3dmDir}) {
-      if (entry.is_regular_file()) {
-        auto path = entry.path();
-        auto name = entry.path().filename();
-
-        if (path.extension() == ".sdata") {
-          auto fileName = t3dmPath.stem().string();
-          if (name.string().starts_with(fileName)) {
-            // path relative to project
-            auto relPath = fs::relative(path, projectPath).string();
-            sceneCtx.files.push_back(Utils::FS::toUnixPath(relPath));
+      // search for all files containing *.sdata
+      for (const auto &entry : fs::directory_iterator{t3dmDir}) {
+        if (entry.is_regular_file()) {
+          auto path = entry.path();
+          auto name = entry.path().filename();
+
+          if (path.extension() == ".sdata") {
+            auto fileName = t3dmPath.stem().string();
+            if (name.string().starts_with(fileName)) {
+              // path relative to project
+              auto relPath = fs::relative(path, projectPath).string();
+              sceneCtx.addFile(Utils::FS::toUnixPath(relPath));
+            }
           }
         }
       }
-    }
+      return true;
+    });
   }
   return true;
 }
\ No newline at end of file
@@ -36,15 +36,24 @@ bool Build::buildTextureAssets(Project::Project &project, SceneCtx &sceneCtx)
     auto assetDir = assetPath.parent_path();
     fs::create_directories(assetDir);
 
-    if(!assetBuildNeeded(image, assetPath.string()))continue;
+    bool isBCI = image.conf.format == (int)Utils::TexFormat::BCI_256;
+    auto toolId = sceneCtx.buildCache.getToolId(isBCI ? fs::path{Utils::Proc::getSelfPath()} : mkSprite);
 
-    int compr = (int)image.conf.compression - 1;
-    if(compr < 0)compr = 1; // @TODO: pull default compression level
-
-    if(image.conf.format == (int)Utils::TexFormat::BCI_256)
+    sceneCtx.jobs.add(image.path, [&sceneCtx, &image, mkSprite, assetPath, assetDir, isBCI, toolId]()
     {
-      BCI::convertPNG(image.path, assetPath.string());
-    } else {
+      if(!assetBuildNeeded(sceneCtx, image, assetPath, toolId))return true;
+
+      int compr = (int)image.conf.compression - 1;
+      if(compr < 0)compr = 1; // @TODO: pull default compression level
+
+      if(isBCI) {
+        // jobs already run on all cores, so the encoder itself stays single-threaded here
+        auto quality = (BCI::Quality)image.conf.bciQuality.value;
+        if(!BCI::convertPNG(image.path, assetPath.string(), quality, 1))return false;
+        assetBuildDone(sceneCtx, assetPath);
+        return true;
+      }
+
       std::string cmd = mkSprite.string() + " -c " + std::to_string(compr);
       if (image.conf.format != 0) {
         cmd += std::string{" -f "} + Utils::TEX_TYPES[image.conf.format];
@@ -52,10 +61,10 @@ bool Build::buildTextureAssets(Project::Project &project, SceneCtx &sceneCtx)
       cmd += " -o \"" + assetDir.string() + "\"";
       cmd += " \"" + image.path + "\"";
 
-      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd)) {
-        return false;
-      }
-    }
+      if(!sceneCtx.toolchain.runCmdSyncLogged(cmd))return false;
+      assetBuildDone(sceneCtx, assetPath);
+      return true;
+    });
   }
   return true;
 }
\ No newline at end of file
@@ -3,32 +3,26 @@
 * @license MIT
 */
 #include "bci.h"
-#include <filesystem>
-#include <vector>
+#include <algorithm>
 #include <array>
-#include <cmath>
-#include <limits>
-#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
 #include "lodepng.h"
-
-using namespace std;
+#include "../../utils/logger.h"
 
 namespace
 {
+  constexpr uint32_t BLOCK_BYTES = 4*2 + 8; // palette (4x RGBA5551) + packed indices
+  constexpr uint32_t MIN_BLOCKS_PER_THREAD = 256;
+
   struct Color {
-    int r, g, b;
-    Color operator+(const Color& other) const {
-      return {r + other.r, g + other.g, b + other.b};
-    }
-    Color operator/(int val) const {
-      return {r / val, g / val, b / val};
-    }
-    double distance(const Color& other) const {
-      return sqrt(pow(r - other.r, 2) + pow(g - other.g, 2) + pow(b - other.b, 2));
-    }
-    bool operator==(const Color&other) const {
-      return r == other.r && g == other.g && b == other.b;
-    }
+    int32_t r, g, b;
+
+    bool operator==(const Color&other) const = default;
+
     uint16_t toRGBA555() const {
       return ((r << 8) & 0b11111'00000'00000'0)
        |     ((g << 3) & 0b00000'11111'00000'0)
@@ -36,165 +30,298 @@ namespace
     }
   };
 
-  using Block = array<Color, 16>;  // 4x4 block of pixels
-  using Palette = array<Color, 4>; // 4-color palette
-  using Indices = array<int, 16>;  // Indices for each pixel in the block
+  // 4x4 block of pixels, stored as separate channels so the distance loops can be vectorized
+  struct Block {
+    alignas(16) int32_t r[16];
+    alignas(16) int32_t g[16];
+    alignas(16) int32_t b[16];
 
-  // Initialize K-means with random colors from the block
-  void initialize_palette(const Block& block, Palette& palette) {
-    for (int i = 0; i < 4; ++i) {
-      palette[i] = block[rand() % 16];
-    }
+    Color get(int i) const { return {r[i], g[i], b[i]}; }
+  };
+
+  using Palette = std::array<Color, 4>;
+  using Indices = std::array<int32_t, 16>;
+
+  struct Preset {
+    uint32_t seedCount;
+    uint32_t maxIters;
+  };
+
+  constexpr Preset PRESETS[3] {
+    {1, 8},   // FAST
+    {2, 24},  // BALANCED
+    {3, 100}, // BEST
+  };
+
+  int32_t distSq(const Color &a, const Color &b) {
+    int32_t dr = a.r - b.r;
+    int32_t dg = a.g - b.g;
+    int32_t db = a.b - b.b;
+    return dr*dr + dg*dg + db*db;
   }
 
-  // Assign each pixel to the nearest palette color
-  Indices assign_clusters(const Block& block, const Palette& palette) {
-    Indices assignments;
+  /**
+   * Assigns each pixel to the nearest palette color.
+   * Squared distances give the same result as the euclidean distance, without any sqrt.
+   * @return sum of squared errors
+   */
+  int32_t assignClusters(const Block& block, const Palette& palette, Indices &assignments)
+  {
+    alignas(16) int32_t minDist[16];
     for (int i = 0; i < 16; ++i) {
-      double min_dist = numeric_limits<double>::max();
-      int best_cluster = 0;
-      for (int j = 0; j < 4; ++j) {
-        double dist = block[i].distance(palette[j]);
-        if (dist < min_dist) {
-          min_dist = dist;
-          best_cluster = j;
-        }
+      minDist[i] = INT32_MAX;
+      assignments[i] = 0;
+    }
+
+    for (int j = 0; j < 4; ++j) {
+      auto pr = palette[j].r;
+      auto pg = palette[j].g;
+      auto pb = palette[j].b;
+      for (int i = 0; i < 16; ++i) {
+        int32_t dr = block.r[i] - pr;
+        int32_t dg = block.g[i] - pg;
+        int32_t db = block.b[i] - pb;
+        int32_t dist = dr*dr + dg*dg + db*db;
+        bool closer = dist < minDist[i];
+        minDist[i] = closer ? dist : minDist[i];
+        assignments[i] = closer ? j : assignments[i];
       }
-      assignments[i] = best_cluster;
     }
-    return assignments;
+
+    int32_t error = 0;
+    for (int i = 0; i < 16; ++i)error += minDist[i];
+    return error;
   }
 
-  // Update palette colors based on assignments
-  void update_palette(const Block& block, Palette& palette, const Indices& assignments) {
-    array<Color, 4> new_colors = {};
-    array<int, 4> counts = {};
+  // Moves each palette color to the average of its assigned pixels
+  Palette updatePalette(const Block& block, const Palette& palette, const Indices& assignments)
+  {
+    std::array<Color, 4> sums{};
+    std::array<int32_t, 4> counts{};
 
     for (int i = 0; i < 16; ++i) {
-      int cluster = assignments[i];
-      new_colors[cluster] = new_colors[cluster] + block[i];
+      auto cluster = assignments[i];
+      sums[cluster].r += block.r[i];
+      sums[cluster].g += block.g[i];
+      sums[cluster].b += block.b[i];
       counts[cluster]++;
     }
 
+    Palette res = palette;
     for (int i = 0; i < 4; ++i) {
       if (counts[i] > 0) {
-        palette[i] = new_colors[i] / counts[i];
+        res[i] = {sums[i].r / counts[i], sums[i].g / counts[i], sums[i].b / counts[i]};
       }
     }
+    return res;
   }
 
-  // K-means clustering to generate a 4-color palette and indices
-  pair<Palette, Indices> kmeansPalette(const Block& block, int max_iters = 100) {
-    Palette palette;
-    initialize_palette(block, palette);
-    Indices assignments;
+  // Seed 0: pixels at the quartiles when sorted by brightness
+  Palette seedLuma(const Block& block)
+  {
+    // sort keys contain the index in the lower bits, which also makes the order stable
+    std::array<int32_t, 16> keys{};
+    for (int i = 0; i < 16; ++i) {
+      keys[i] = ((block.r[i]*77 + block.g[i]*150 + block.b[i]*29) << 4) | i;
+    }
+    std::sort(keys.begin(), keys.end());
+    return {block.get(keys[0] & 15), block.get(keys[5] & 15), block.get(keys[10] & 15), block.get(keys[15] & 15)};
+  }
 
-    for (int iter = 0; iter < max_iters; ++iter) {
-      assignments = assign_clusters(block, palette);
-      Palette new_palette = palette;
-      update_palette(block, new_palette, assignments);
+  // Seed 1: greedy farthest-point selection, starting with the pixel farthest from the average
+  Palette seedFarthest(const Block& block)
+  {
+    Color avg{};
+    for (int i = 0; i < 16; ++i) {
+      avg.r += block.r[i];
+      avg.g += block.g[i];
+      avg.b += block.b[i];
+    }
+    avg = {avg.r / 16, avg.g / 16, avg.b / 16};
+
+    Palette res{};
+    std::array<int32_t, 16> minDist{};
+    minDist.fill(INT32_MAX);
+
+    Color ref = avg;
+    for (int j = 0; j < 4; ++j) {
+      int32_t bestIdx = 0;
+      int32_t bestDist = -1;
+      for (int i = 0; i < 16; ++i) {
+        // first pick is relative to the average, the following ones to all picked colors
+        auto dist = distSq(block.get(i), ref);
+        if (j > 0)minDist[i] = std::min(minDist[i], dist);
+        auto score = (j > 0) ? minDist[i] : dist;
+        if (score > bestDist) {
+          bestDist = score;
+          bestIdx = i;
+        }
+      }
+      res[j] = block.get(bestIdx);
+      ref = res[j];
+    }
+    return res;
+  }
 
-      if (palette == new_palette) break; // Converged
-      palette = new_palette;
+  // Seed 2: evenly spaced along the diagonal of the color bounding-box
+  Palette seedBounds(const Block& block)
+  {
+    Color cMin{255, 255, 255};
+    Color cMax{0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+      cMin = {std::min(cMin.r, block.r[i]), std::min(cMin.g, block.g[i]), std::min(cMin.b, block.b[i])};
+      cMax = {std::max(cMax.r, block.r[i]), std::max(cMax.g, block.g[i]), std::max(cMax.b, block.b[i])};
     }
 
-    return {palette, assignments};
+    Palette res{};
+    for (int j = 0; j < 4; ++j) {
+      res[j] = {
+        cMin.r + (cMax.r - cMin.r) * j / 3,
+        cMin.g + (cMax.g - cMin.g) * j / 3,
+        cMin.b + (cMax.b - cMin.b) * j / 3,
+      };
+    }
+    return res;
   }
-}
 
-bool Build::BCI::convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI)
-{
-  vector<unsigned char> image;
-  unsigned width, height;
+  // K-means clustering to generate a 4-color palette and indices
+  std::pair<Palette, Indices> kmeansPalette(const Block& block, const Preset &preset)
+  {
+    Palette bestPalette{};
+    Indices bestIndices{};
+    int32_t bestError = INT32_MAX;
 
-  auto *pFile = fopen(pathOutBCI.c_str(), "wb");
+    for (uint32_t s = 0; s < preset.seedCount; ++s)
+    {
+      Palette palette = s == 0 ? seedLuma(block)
+                      : s == 1 ? seedFarthest(block)
+                      : seedBounds(block);
+      Indices assignments{};
+      int32_t error = assignClusters(block, palette, assignments);
 
-  auto writeU16 = [pFile](uint16_t val) {
-    uint8_t high = (val >> 8) & 0xFF;
-    uint8_t low = val & 0xFF;
-    fwrite(&high, 1, 1, pFile);
-    fwrite(&low, 1, 1, pFile);
-  };
-  auto writeU8 = [pFile](uint8_t val) {
-    fwrite(&val, 1, 1, pFile);
-  };
-  auto writeU32 = [pFile](uint32_t val) {
-    uint8_t b0 = (val >> 24) & 0xFF;
-    uint8_t b1 = (val >> 16) & 0xFF;
-    uint8_t b2 = (val >> 8) & 0xFF;
-    uint8_t b3 = val & 0xFF;
-    fwrite(&b0, 1, 1, pFile);
-    fwrite(&b1, 1, 1, pFile);
-    fwrite(&b2, 1, 1, pFile);
-    fwrite(&b3, 1, 1, pFile);
-  };
-  auto writeU64 = [pFile](uint64_t val) {
-    uint8_t b0 = (val >> 56) & 0xFF;
-    uint8_t b1 = (val >> 48) & 0xFF;
-    uint8_t b2 = (val >> 40) & 0xFF;
-    uint8_t b3 = (val >> 32) & 0xFF;
-    uint8_t b4 = (val >> 24) & 0xFF;
-    uint8_t b5 = (val >> 16) & 0xFF;
-    uint8_t b6 = (val >> 8) & 0xFF;
-    uint8_t b7 = val & 0xFF;
-    fwrite(&b0, 1, 1, pFile);
-    fwrite(&b1, 1, 1, pFile);
-    fwrite(&b2, 1, 1, pFile);
-    fwrite(&b3, 1, 1, pFile);
-    fwrite(&b4, 1, 1, pFile);
-    fwrite(&b5, 1, 1, pFile);
-    fwrite(&b6, 1, 1, pFile);
-    fwrite(&b7, 1, 1, pFile);
-  };
+      for (uint32_t iter = 0; iter < preset.maxIters && error > 0; ++iter) {
+        Palette newPalette = updatePalette(block, palette, assignments);
+        if (newPalette == palette)break; // converged
+        palette = newPalette;
+        error = assignClusters(block, palette, assignments);
+      }
 
-  unsigned error = lodepng::decode(image, width, height, pathInPNG);
-  if (error) {
-    cerr << "PNG loading error: " << lodepng_error_text(error) << endl;
-    return false;
+      if (error < bestError) {
+        bestError = error;
+        bestPalette = palette;
+        bestIndices = assignments;
+      }
+      if (bestError == 0)break; // can't get any better
+    }
+
+    return {bestPalette, bestIndices};
   }
 
-  for (unsigned y = 0; y < height; y += 4) {
-    for (unsigned x = 0; x < width; x += 4) {
-      Block block;
-      for (int i = 0; i < 16; ++i) {
-        unsigned px = x + (i % 4);
-        unsigned py = y + (i / 4);
-        if (px >= width || py >= height) continue;
-        unsigned index = 4 * (py * width + px);
-        block[i] = {image[index], image[index + 1], image[index + 2]};
-      }
+  void putU16(uint8_t* &out, uint16_t val) {
+    *out++ = (val >> 8) & 0xFF;
+    *out++ = val & 0xFF;
+  }
 
-      auto [palette, indices] = kmeansPalette(block);
+  void putU64(uint8_t* &out, uint64_t val) {
+    for (int i = 7; i >= 0; --i) {
+      *out++ = (val >> (i*8)) & 0xFF;
+    }
+  }
 
-      // Note: the first index must be 0b00 or 0b01 due to runtime opt.
-      // If that is not the case, swap the colors and indices
-      if(indices[15] != 0) {
-        auto replA = indices[15];
+  void encodeBlock(const std::vector<uint8_t> &image, unsigned width, unsigned height,
+    unsigned x, unsigned y, const Preset &preset, uint8_t *out)
+  {
+    Block block;
+    for (int i = 0; i < 16; ++i) {
+      // repeat the last row/column for blocks on the edge
+      unsigned px = std::min(x + (i % 4), width - 1);
+      unsigned py = std::min(y + (i / 4), height - 1);
+      unsigned index = 4 * (py * width + px);
+      block.r[i] = image[index];
+      block.g[i] = image[index + 1];
+      block.b[i] = image[index + 2];
+    }
 
-        auto tmp = palette[replA];
-        palette[replA] = palette[0];
-        palette[0] = tmp;
+    auto [palette, indices] = kmeansPalette(block, preset);
 
-        for(uint32_t i=0; i<16; ++i) {
-          if(indices[i] == replA)indices[i] = 0;
-          else if(indices[i] == 0)indices[i] = replA;
-        }
+    // Note: the first index must be 0b00 or 0b01 due to runtime opt.
+    // If that is not the case, swap the colors and indices
+    if(indices[15] != 0) {
+      auto replA = indices[15];
+      std::swap(palette[replA], palette[0]);
+
+      for(uint32_t i=0; i<16; ++i) {
+        if(indices[i] == replA)indices[i] = 0;
+        else if(indices[i] == 0)indices[i] = replA;
       }
+    }
 
-      writeU16(palette[0].toRGBA555());
-      writeU16(palette[1].toRGBA555());
-      writeU16(palette[2].toRGBA555());
-      writeU16(palette[3].toRGBA555());
+    for(auto &col : palette) {
+      putU16(out, col.toRGBA555());
+    }
 
-      uint64_t packedIndex = 0;
-      for(int i=0; i<16; ++i) {
-        packedIndex <<= 2;
-        packedIndex |= indices[15-i];
+    uint64_t packedIndex = 0;
+    for(int i=0; i<16; ++i) {
+      packedIndex <<= 2;
+      packedIndex |= indices[15-i];
+    }
+    putU64(out, packedIndex << 33);
+  }
+}
+
+std::vector<uint8_t> Build::BCI::encode(const std::vector<uint8_t> &rgba, uint32_t width, uint32_t height,
+  Quality quality, uint32_t threadCount)
+{
+  const auto &preset = PRESETS[std::clamp((int)quality, 0, 2)];
+  uint32_t blocksX = (width + 3) / 4;
+  uint32_t blocksY = (height + 3) / 4;
+  std::vector<uint8_t> data(blocksX * blocksY * BLOCK_BYTES);
+
+  // each row of blocks writes into its own part of the output, so the order of work doesn't matter
+  std::atomic_uint32_t nextRow{0};
+  auto worker = [&]() {
+    for (uint32_t by = nextRow++; by < blocksY; by = nextRow++) {
+      uint8_t *out = data.data() + by * blocksX * BLOCK_BYTES;
+      for (uint32_t bx = 0; bx < blocksX; ++bx) {
+        encodeBlock(rgba, width, height, bx * 4, by * 4, preset, out + bx * BLOCK_BYTES);
       }
-      writeU64(packedIndex << 33);
     }
+  };
+
+  if (threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  threadCount = std::clamp(blocksX * blocksY / MIN_BLOCKS_PER_THREAD, 1u, threadCount);
+
+  std::vector<std::thread> threads{};
+  for (uint32_t i = 1; i < threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &t : threads)t.join();
+
+  return data;
+}
+
+bool Build::BCI::convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI, Quality quality, uint32_t threadCount)
+{
+  std::vector<unsigned char> image;
+  unsigned width, height;
+
+  unsigned error = lodepng::decode(image, width, height, pathInPNG);
+  if (error) {
+    Utils::Logger::log("PNG loading error: " + std::string{lodepng_error_text(error)}, Utils::Logger::LEVEL_ERROR);
+    return false;
   }
 
+  auto data = encode(image, width, height, quality, threadCount);
+
+  auto *pFile = fopen(pathOutBCI.c_str(), "wb");
+  if (!pFile) {
+    Utils::Logger::log("Failed to write BCI file: " + pathOutBCI, Utils::Logger::LEVEL_ERROR);
+    return false;
+  }
+  bool success = fwrite(data.data(), 1, data.size(), pFile) == data.size();
   fclose(pFile);
-  return true;
+  return success;
 }
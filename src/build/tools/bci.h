@@ -3,9 +3,32 @@
 * @license MIT
 */
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Build::BCI
 {
-  bool convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI);
+  enum class Quality : int
+  {
+    FAST = 0,     // single seed, few iterations
+    BALANCED = 1, // two seeds
+    BEST = 2,     // all seeds, iterates until converged
+  };
+
+  /**
+   * Encodes RGBA8 pixels into BCI blocks (4x4 pixels with a 4-color palette each).
+   * The result is deterministic for a given quality, independent of the thread count.
+   * @param threadCount max. number of threads to encode with, 0 to use the number of CPU cores
+   * @return blocks in row-major order
+   */
+  std::vector<uint8_t> encode(const std::vector<uint8_t> &rgba, uint32_t width, uint32_t height,
+    Quality quality, uint32_t threadCount = 0);
+
+  /**
+   * Converts a PNG into a BCI texture, see 'encode'.
+   * Callers already running in parallel (e.g. from a 'JobGraph') should pass a 'threadCount' of 1.
+   */
+  bool convertPNG(const std::string &pathInPNG, const std::string &pathOutBCI,
+    Quality quality = Quality::BALANCED, uint32_t threadCount = 0);
 }
@@ -44,6 +44,11 @@ void Editor::AssetInspector::draw() {
     if (asset->type == FileType::IMAGE)
     {
       ImTable::addComboBox("Format", asset->conf.format, Utils::TEX_TYPES, Utils::TEX_TYPE_COUNT);
+      if (asset->conf.format == (int)Utils::TexFormat::BCI_256) {
+        ImTable::addComboBox("BCI Quality", asset->conf.bciQuality.value, {
+          "Fast", "Balanced", "Best",
+        });
+      }
     }
     else if (asset->type == FileType::MODEL_3D)
     {
@@ -52,6 +57,7 @@ void Editor::AssetInspector::draw() {
       }
       ImTable::addCheckBox("Create BVH", asset->conf.gltfBVH);
       ImTable::addProp("Collision", asset->conf.gltfCollision);
+      ImTable::addProp("Coll. Edge-Data", asset->conf.gltfCollEdges);
     } else if (asset->type == FileType::FONT)
     {
       ImTable::add("Size", asset->conf.baseScale);
@@ -163,6 +163,14 @@ void Editor::AssetsBrowser::draw() {
     }
     ImGui::PopStyleVar(2);
 
+    auto &assetManager = ctx.project->getAssets();
+    if (assetManager.isLoading()) {
+      ImGui::SameLine();
+      ImGui::TextDisabled("Loading %u/%u",
+        assetManager.getLoadTotal() - assetManager.getLoadPending(), assetManager.getLoadTotal()
+      );
+    }
+
     // search field on the right side
     ImGui::SameLine();
     ImGui::SetCursorPosX(ImGui::GetContentRegionAvail().x + ImGui::GetCursorPosX() - 160 - 2);
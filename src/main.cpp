@@ -271,7 +271,7 @@ int main(int argc, char** argv)
 
       Utils::FilePicker::poll();
       if (ctx.project) {
-        ctx.project->getAssets().pollWatch();
+        ctx.project->getAssets().update();
       }
 
       if(SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
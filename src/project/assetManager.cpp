@@ -7,7 +7,7 @@
 #include <filesystem>
 #include <format>
 #include <chrono>
-#include <unordered_set>
+#include <climits>
 
 #include "SHA256.h"
 #include "../utils/codeParser.h"
@@ -19,7 +19,8 @@
 #include "../utils/meshGen.h"
 #include "../utils/string.h"
 #include "../utils/textureFormats.h"
-#include "tiny3d/tools/gltf_importer/src/parser.h"
+#include "assets/gltfImport.h"
+#include "assets/modelCache.h"
 
 namespace fs = std::filesystem;
 
@@ -67,6 +68,8 @@ namespace
       conf.compression = (Project::ComprTypes)doc.value<int>("compression", 0);
       conf.gltfBVH = doc["gltfBVH"];
       Utils::JSON::readProp(doc, conf.gltfCollision);
+      Utils::JSON::readProp(doc, conf.gltfCollEdges);
+      Utils::JSON::readProp(doc, conf.bciQuality, 1);
       Utils::JSON::readProp(doc, conf.wavForceMono);
       Utils::JSON::readProp(doc, conf.wavResampleRate);
       Utils::JSON::readProp(doc, conf.wavCompression);
@@ -77,6 +80,50 @@ namespace
     }
   }
 
+  Project::Assets::GLTF::Config getImportConfig(Project::Project *project, const Project::AssetConf &conf)
+  {
+    return {
+      .globalScale = (float)conf.baseScale,
+      .animSampleRate = 60,
+      //.ignoreMaterials = args.checkArg("--ignore-materials"),
+      //.ignoreTransforms = args.checkArg("--ignore-transforms"),
+      .createBVH = conf.gltfBVH,
+      .verbose = false,
+      .assetPath = "assets/",
+      .assetPathFull = fs::absolute(project->getPath() + "/assets").string(),
+    };
+  }
+
+  // parsing glTF files is slow, so the result is cached in the project's build directory
+  fs::path getModelCachePath(Project::Project *project, const std::string &path)
+  {
+    auto cacheName = Utils::toHex64(Utils::Hash::sha256_64bit(Utils::FS::toUnixPath(path))) + ".bin";
+    return fs::path{project->getPath()} / "build" / "modelCache" / cacheName;
+  }
+
+  bool loadModelCached(Project::Project *project, const std::string &path,
+    const Project::Assets::GLTF::Config &conf, T3DM::T3DMData &res)
+  {
+    auto key = Project::Assets::ModelCache::getKey(path, conf);
+    return Project::Assets::ModelCache::load(getModelCachePath(project, path), key, res);
+  }
+
+  T3DM::T3DMData parseModel(Project::Project *project, const std::string &path, const Project::Assets::GLTF::Config &conf)
+  {
+    auto res = Project::Assets::GLTF::parse(path, conf);
+    Project::Assets::ModelCache::save(getModelCachePath(project, path), Project::Assets::ModelCache::getKey(path, conf), res);
+    return res;
+  }
+
+  T3DM::T3DMData loadModel(Project::Project *project, const std::string &path, const Project::Assets::GLTF::Config &conf)
+  {
+    T3DM::T3DMData res{};
+    if (loadModelCached(project, path, conf, res)) {
+      return res;
+    }
+    return parseModel(project, path, conf);
+  }
+
   bool buildAssetEntry(Project::Project *project, const fs::path &path, Project::AssetManagerEntry &entry)
   {
     auto projectBase = fs::absolute(project->getPath()).string();
@@ -121,6 +168,7 @@ namespace
     };
 
     entry.conf.baseScale = 16;
+    entry.conf.bciQuality.value = 1;
 
     auto pathMeta = path;
     pathMeta += ".conf";
@@ -199,6 +247,8 @@ std::string Project::AssetConf::serialize() const {
     .set("compression", static_cast<int>(compression))
     .set("gltfBVH", gltfBVH)
     .set(gltfCollision)
+    .set(gltfCollEdges)
+    .set(bciQuality)
     .set(wavForceMono)
     .set(wavResampleRate)
     .set(wavCompression)
@@ -215,7 +265,11 @@ Project::AssetManager::AssetManager(Project* pr)
 }
 
 Project::AssetManager::~AssetManager() {
-
+  // workers write back into this object
+  loadPool.clear();
+  loadPool.wait();
+  modelPool.clear();
+  modelPool.wait();
 }
 
 void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::string &path)
@@ -237,18 +291,7 @@ void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::str
     case FileType::MODEL_3D:
     {
       try{
-        T3DM::config = {
-          .globalScale = (float)entry.conf.baseScale,
-          .animSampleRate = 60,
-          //.ignoreMaterials = args.checkArg("--ignore-materials"),
-          //.ignoreTransforms = args.checkArg("--ignore-transforms"),
-          .createBVH = entry.conf.gltfBVH,
-          .verbose = false,
-          .assetPath = "assets/",
-          .assetPathFull = fs::absolute(project->getPath() + "/assets").string(),
-        };
-
-        entry.t3dmData = T3DM::parseGLTF(path.c_str());
+        entry.t3dmData = loadModel(project, path, getImportConfig(project, entry.conf));
         if (!entry.t3dmData.models.empty()) {
           if (!entry.mesh3D) {
             entry.mesh3D = std::make_shared<Renderer::N64Mesh>();
@@ -265,67 +308,221 @@ void Project::AssetManager::reloadEntry(AssetManagerEntry &entry, const std::str
   }
 }
 
-void Project::AssetManager::reload() {
-  for (auto &e : entries)e.clear();
-  entriesMap.clear();
-  watchFiles.clear();
-  watchInitialized = false;
+void Project::AssetManager::queueLoad(AssetManagerEntry &entry)
+{
+  entry.loadState = LoadState::LOADING;
+  ++loadTotal;
+  ++loadPending;
+  if (entry.type == FileType::IMAGE)++loadPendingTex;
+
+  LoadResult res{
+    .path = entry.path,
+    .generation = loadGeneration,
+    .type = entry.type,
+  };
+  bool isMono = Utils::isTexFormatMono(static_cast<Utils::TexFormat>(entry.conf.format));
+  auto importConf = getImportConfig(project, entry.conf);
 
-  auto assetPath = fs::path{project->getPath()} / "assets";
-  if (!fs::exists(assetPath)) {
-    fs::create_directory(assetPath);
-  }
+  loadPool.push([this, res = std::move(res), isMono, importConf = std::move(importConf)]() mutable
+  {
+    if (res.generation != loadGeneration)return; // outdated by a newer reload
 
-  // scan all files
-  for (const auto &entry : fs::recursive_directory_iterator{assetPath}) {
-    if (entry.is_regular_file()) {
-      auto path = entry.path();
-      watchFiles[path.string()] = Utils::FS::getFileAge(path);
-      AssetManagerEntry assetEntry{};
-      if (!buildAssetEntry(project, path, assetEntry)) {
-        continue;
+    if (res.type == FileType::IMAGE) {
+      res.image = Renderer::Texture::loadImage(res.path, isMono);
+      res.success = res.image.isValid();
+      if (!res.success) {
+        Utils::Logger::log("Failed to load image asset: " + res.path, Utils::Logger::LEVEL_ERROR);
       }
+    } else if (res.type == FileType::MODEL_3D) {
+      res.success = loadModelCached(project, res.path, importConf, res.t3dmData);
+
+      // The importer can only parse one file at a time (see 'GLTF::ImportLock').
+      // Parsing on a separate thread avoids blocking the pool, so images and cached models keep loading meanwhile.
+      if (!res.success) {
+        modelPool.push([this, res = std::move(res), importConf = std::move(importConf)]() mutable
+        {
+          if (res.generation != loadGeneration)return;
+          try {
+            res.t3dmData = parseModel(project, res.path, importConf);
+            res.success = true;
+          } catch (std::exception &e) {
+            Utils::Logger::log("Failed to load 3D model asset: " + res.path + " - " + e.what(), Utils::Logger::LEVEL_ERROR);
+          }
 
-      if (assetEntry.type == FileType::IMAGE) {
-        if (ctx.window) {
-          reloadEntry(assetEntry, path.string());
-        }
+          std::lock_guard lock{mtxLoad};
+          loadResults.push_back(std::move(res));
+        });
+        return;
       }
+    }
 
-      if (assetEntry.type == FileType::PREFAB) {
-        reloadEntry(assetEntry, path.string());
-        if (assetEntry.prefab) {
-          assetEntry.conf.uuid = assetEntry.prefab->uuid.value;
-        }
-      }
+    std::lock_guard lock{mtxLoad};
+    loadResults.push_back(std::move(res));
+  });
+}
+
+void Project::AssetManager::applyLoad(LoadResult &res)
+{
+  --loadPending;
+  if (res.type == FileType::IMAGE)--loadPendingTex;
+
+  // entry may have been removed or reloaded directly since
+  auto entry = getByPath(res.path);
+  if (!entry || entry->loadState != LoadState::LOADING)return;
 
-      entries[(int)assetEntry.type].push_back(assetEntry);
+  if (!res.success) {
+    entry->loadState = LoadState::FAILED;
+    return;
+  }
+
+  if (res.type == FileType::IMAGE) {
+    entry->texture = std::make_shared<Renderer::Texture>(ctx.gpu, res.image);
+  } else if (res.type == FileType::MODEL_3D) {
+    entry->t3dmData = std::move(res.t3dmData);
+    if (!entry->t3dmData.models.empty()) {
+      if (!entry->mesh3D) {
+        entry->mesh3D = std::make_shared<Renderer::N64Mesh>();
+      }
+      entry->mesh3D->fromT3DM(entry->t3dmData, *this);
     }
   }
+  entry->loadState = LoadState::READY;
+}
 
-  // now load models (after all textures are there now)
-  for (auto &typed : entries) {
-    for (auto &entry : typed) {
-      if (entry.type == FileType::MODEL_3D) {
-        reloadEntry(entry, entry.path);
+void Project::AssetManager::finishLoads(bool blocking)
+{
+  // max. time per frame spent on uploads, to keep the editor responsive
+  constexpr auto kTimeBudget = std::chrono::milliseconds(8);
+  auto timeStart = std::chrono::steady_clock::now();
+
+  for (;;)
+  {
+    if (blocking) {
+      loadPool.wait(); // may still queue model parses
+      modelPool.wait();
+    }
+    {
+      std::lock_guard lock{mtxLoad};
+      for (auto &res : loadResults)loadApply.push_back(std::move(res));
+      loadResults.clear();
+    }
+
+    while (!loadApply.empty())
+    {
+      if (!blocking && (std::chrono::steady_clock::now() - timeStart) > kTimeBudget)return;
+
+      auto res = std::move(loadApply.front());
+      loadApply.pop_front();
+      if (res.generation != loadGeneration)continue;
+
+      // models reference textures on creation, so wait until all of them are there
+      if (res.type == FileType::MODEL_3D && loadPendingTex > 0) {
+        loadDeferred.push_back(std::move(res));
+        continue;
       }
+      applyLoad(res);
+    }
+
+    if (loadPendingTex == 0 && !loadDeferred.empty()) {
+      for (auto &res : loadDeferred)loadApply.push_back(std::move(res));
+      loadDeferred.clear();
+      continue;
     }
+    break;
   }
 
+  if (loadPending == 0)loadTotal = 0;
+}
+
+void Project::AssetManager::update()
+{
+  if (loadPending > 0) {
+    finishLoads(false);
+  }
+  pollWatch();
+}
+
+void Project::AssetManager::reload() {
+  // drop everything still in flight from a previous reload
+  ++loadGeneration;
+  loadPool.clear();
+  modelPool.clear();
+  {
+    std::lock_guard lock{mtxLoad};
+    loadResults.clear();
+  }
+  loadApply.clear();
+  loadDeferred.clear();
+  loadTotal = 0;
+  loadPending = 0;
+  loadPendingTex = 0;
+
+  for (auto &e : entries)e.clear();
+  watchFiles.clear();
+  watchInitialized = false;
+
+  auto assetPath = getAssetPath(project);
   auto codePath = getCodePath(project);
+
+  // only the editor itself loads in the background, CLI and builds need all data right away
+  bool isEditor = ctx.window && SDL_IsMainThread();
+
+  // start watching before the scan, so that no change can slip through in-between
+  if (isEditor && !watcher.isActive()) {
+    watcher.start({assetPath, codePath});
+  }
+
+  // scan all files
+  std::vector<fs::path> assetFiles{};
+  for (const auto &entry : fs::recursive_directory_iterator{assetPath}) {
+    if (entry.is_regular_file()) {
+      auto path = entry.path();
+      watchFiles[path.string()] = Utils::FS::getFileAge(path);
+      assetFiles.push_back(path);
+    }
+  }
+
+  std::vector<fs::path> codeFiles{};
   for (const auto &entry : fs::recursive_directory_iterator{codePath}) {
     if (entry.is_regular_file()) {
       auto path = entry.path();
       if (path.extension().string() != ".cpp") continue;
 
       watchFiles[path.string()] = Utils::FS::getFileAge(path);
-      AssetManagerEntry codeEntry{};
-      if (!buildCodeEntry(path, codeEntry)) {
-        continue;
-      }
+      codeFiles.push_back(path);
+    }
+  }
+
+  // read settings and scripts in parallel, each task only writes to its own slot
+  std::vector<AssetManagerEntry> newEntries(assetFiles.size() + codeFiles.size());
+  std::vector<uint8_t> newEntriesValid(newEntries.size(), 0);
+
+  for (size_t i = 0; i < assetFiles.size(); ++i) {
+    loadPool.push([&, i]() {
+      newEntriesValid[i] = buildAssetEntry(project, assetFiles[i], newEntries[i]);
+    });
+  }
+  for (size_t i = 0; i < codeFiles.size(); ++i) {
+    size_t idx = assetFiles.size() + i;
+    loadPool.push([&, i, idx]() {
+      newEntriesValid[idx] = buildCodeEntry(codeFiles[i], newEntries[idx]);
+    });
+  }
+  loadPool.wait();
 
-      entries[(int)codeEntry.type].push_back(codeEntry);
+  for (size_t i = 0; i < newEntries.size(); ++i) {
+    if (!newEntriesValid[i])continue;
+    auto &assetEntry = newEntries[i];
+
+    // prefabs define their own UUID, which is needed right away
+    if (assetEntry.type == FileType::PREFAB) {
+      reloadEntry(assetEntry, assetEntry.path);
+      if (assetEntry.prefab) {
+        assetEntry.conf.uuid = assetEntry.prefab->uuid.value;
+      }
     }
+
+    entries[(int)assetEntry.type].push_back(std::move(assetEntry));
   }
 
   // sort by name
@@ -335,19 +532,38 @@ void Project::AssetManager::reload() {
     });
   }
 
-  for (auto &typed : entries)
-  {
-    int idx = 0;
-    for (auto &entry : typed)
-    {
-      entriesMap[entry.getUUID()] = {(int)entry.type, idx};
-      ++idx;
+  rebuildIndex();
+
+  // decode images and models in the background, models are uploaded after all textures
+  if (isEditor) {
+    for (auto &entry : entries[(int)FileType::IMAGE]) {
+      queueLoad(entry);
     }
   }
+  for (auto &entry : entries[(int)FileType::MODEL_3D]) {
+    queueLoad(entry);
+  }
+
+  if (!isEditor) {
+    finishLoads(true);
+  }
 }
 
 bool Project::AssetManager::pollWatch()
 {
+  if (watcher.isActive()) {
+    // wait a bit after the last change, files may still be written to
+    constexpr auto kSettleTime = std::chrono::milliseconds(150);
+
+    bool needsRescan = false;
+    auto events = watcher.fetchEvents(kSettleTime, needsRescan);
+    if (needsRescan) {
+      Utils::Logger::log("Too many file changes, rescanning assets", Utils::Logger::LEVEL_WARN);
+      return pollScan();
+    }
+    return applyWatchEvents(events);
+  }
+
   using Clock = std::chrono::steady_clock;
   // Check for changes every 2 seconds
   constexpr auto kMinInterval = std::chrono::milliseconds(2000);
@@ -358,7 +574,174 @@ bool Project::AssetManager::pollWatch()
   }
   watchInitialized = true;
   watchLastCheck = now;
+  return pollScan();
+}
+
+bool Project::AssetManager::applyWatchEvents(const std::vector<Utils::FileWatcher::Event> &events)
+{
+  if (events.empty())return false;
+
+  auto codePrefix = getCodePath(project).string() + "/";
+  std::vector<std::string> modelReloadPaths{};
+
+  auto findEntry = [&](const std::string &pathStr) -> std::pair<int, size_t> {
+    auto it = pathMap.find(getPathKey(pathStr));
+    if (it == pathMap.end())return {-1, 0};
+    return {it->second.first, (size_t)it->second.second};
+  };
+
+  for (const auto &ev : events)
+  {
+    if (ev.type == Utils::FileWatcher::EventType::DELETED && ev.isDir) {
+      auto prefix = ev.path + "/";
+      for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
+        auto &typed = entries[typeIdx];
+        for (size_t i = typed.size(); i-- > 0;) {
+          if (typed[i].path.starts_with(prefix))removeEntry((int)typeIdx, i);
+        }
+      }
+      continue;
+    }
+
+    auto [oldType, oldIdx] = findEntry(ev.path);
+
+    // events are coalesced, the file may already be gone again
+    AssetManagerEntry newEntry{};
+    bool isValid = false;
+    if (ev.type != Utils::FileWatcher::EventType::DELETED && fs::is_regular_file(ev.path)) {
+      if (ev.path.starts_with(codePrefix)) {
+        isValid = fs::path{ev.path}.extension() == ".cpp" && buildCodeEntry(ev.path, newEntry);
+      } else {
+        isValid = buildAssetEntry(project, ev.path, newEntry);
+      }
+    }
+
+    if (!isValid) {
+      if (oldType >= 0)removeEntry(oldType, oldIdx);
+      continue;
+    }
+
+    AssetManagerEntry *entry = nullptr;
+    if (oldType == (int)newEntry.type) {
+      // update in place, the position only depends on the name which can't change here
+      auto &oldEntry = entries[oldType][oldIdx];
+      newEntry.mesh3D = oldEntry.mesh3D; // re-use GPU buffers
+      unindexEntry(oldEntry, oldType, (int)oldIdx);
+      oldEntry = std::move(newEntry);
+      indexEntry(oldEntry, oldType, (int)oldIdx);
+      entry = &oldEntry;
+    } else {
+      if (oldType >= 0)removeEntry(oldType, oldIdx);
+      entry = insertEntry(std::move(newEntry));
+    }
+
+    if (entry->type == FileType::MODEL_3D) {
+      modelReloadPaths.push_back(entry->path);
+    } else if (entry->type == FileType::IMAGE || entry->type == FileType::PREFAB) {
+      reloadEntry(*entry, entry->path);
+      if (entry->type == FileType::PREFAB && entry->prefab && entry->getUUID() != entry->prefab->uuid.value) {
+        auto [type, idx] = findEntry(entry->path);
+        unindexEntry(*entry, type, (int)idx);
+        entry->conf.uuid = entry->prefab->uuid.value;
+        indexEntry(*entry, type, (int)idx);
+      }
+    }
+  }
+
+  // Reload models after texture updates are applied
+  for (const auto &pathStr : modelReloadPaths) {
+    auto entry = getByPath(pathStr);
+    if (entry) {
+      reloadEntry(*entry, entry->path);
+    }
+  }
+  return true;
+}
+
+std::string Project::AssetManager::getPathKey(const std::string &path)
+{
+  return Utils::FS::toUnixPath(fs::path{path}.lexically_normal());
+}
+
+void Project::AssetManager::indexEntry(const AssetManagerEntry &entry, int type, int idx)
+{
+  auto key = getPathKey(entry.path);
+  entriesMap[entry.getUUID()] = {type, idx};
+  pathMap[key] = {type, idx};
+  nameMap[entry.name].push_back(std::move(key));
+}
+
+void Project::AssetManager::unindexEntry(const AssetManagerEntry &entry, int type, int idx)
+{
+  auto key = getPathKey(entry.path);
+  std::pair<int, int> pos{type, idx};
+
+  // UUIDs are not guaranteed to be unique (e.g. copied '.conf' files), only remove our own
+  auto itUUID = entriesMap.find(entry.getUUID());
+  if (itUUID != entriesMap.end() && itUUID->second == pos) {
+    entriesMap.erase(itUUID);
+  }
+
+  pathMap.erase(key);
+
+  auto itName = nameMap.find(entry.name);
+  if (itName != nameMap.end()) {
+    std::erase(itName->second, key);
+    if (itName->second.empty())nameMap.erase(itName);
+  }
+}
+
+void Project::AssetManager::rebuildIndex()
+{
+  entriesMap.clear();
+  pathMap.clear();
+  nameMap.clear();
 
+  for (auto &typed : entries)
+  {
+    int idx = 0;
+    for (auto &entry : typed)
+    {
+      indexEntry(entry, (int)entry.type, idx);
+      ++idx;
+    }
+  }
+}
+
+void Project::AssetManager::reindexEntries(int type, size_t startIdx)
+{
+  auto &typed = entries[type];
+  for (size_t i = startIdx; i < typed.size(); ++i) {
+    entriesMap[typed[i].getUUID()] = {type, (int)i};
+    pathMap[getPathKey(typed[i].path)] = {type, (int)i};
+  }
+}
+
+Project::AssetManagerEntry* Project::AssetManager::insertEntry(AssetManagerEntry &&entry)
+{
+  int type = (int)entry.type;
+  auto &typed = entries[type];
+  auto it = std::upper_bound(typed.begin(), typed.end(), entry.name, [](const std::string &name, const AssetManagerEntry &e) {
+    return name < e.name;
+  });
+
+  size_t idx = it - typed.begin();
+  typed.insert(it, std::move(entry));
+  indexEntry(typed[idx], type, (int)idx);
+  reindexEntries(type, idx + 1);
+  return &typed[idx];
+}
+
+void Project::AssetManager::removeEntry(int type, size_t idx)
+{
+  auto &typed = entries[type];
+  unindexEntry(typed[idx], type, (int)idx);
+  typed.erase(typed.begin() + idx);
+  reindexEntries(type, idx);
+}
+
+bool Project::AssetManager::pollScan()
+{
   // Snapshot current files so we can diff against watchFiles
   std::unordered_map<std::string, uint64_t> currentFiles{};
   std::vector<std::string> addedAssets{};
@@ -422,24 +805,14 @@ bool Project::AssetManager::pollWatch()
     return false;
   }
 
-  // Track which entry lists we need to re-sort
-  std::unordered_set<int> touchedTypes{};
   std::vector<std::string> modelReloadPaths{};
 
   // Remove an entry by absolute path across all lists
   auto removeEntryByPath = [&](const std::string &pathStr) {
-    fs::path pathIn{pathStr};
-    for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
-      auto &typed = entries[typeIdx];
-      for (size_t i = 0; i < typed.size(); ++i) {
-        if (fs::path{typed[i].path} == pathIn) {
-          typed.erase(typed.begin() + i);
-          touchedTypes.insert(static_cast<int>(typeIdx));
-          return true;
-        }
-      }
-    }
-    return false;
+    auto it = pathMap.find(getPathKey(pathStr));
+    if (it == pathMap.end())return false;
+    removeEntry(it->second.first, it->second.second);
+    return true;
   };
 
   for (const auto &pathStr : removedPaths) {
@@ -454,13 +827,7 @@ bool Project::AssetManager::pollWatch()
     }
 
     removeEntryByPath(pathStr);
-    entries[static_cast<int>(newEntry.type)].push_back(std::move(newEntry));
-    touchedTypes.insert(static_cast<int>(newEntry.type));
-
-    auto entry = getByPath(pathStr);
-    if (!entry) {
-      return;
-    }
+    auto entry = insertEntry(std::move(newEntry));
 
     if (entry->type == FileType::MODEL_3D) {
       modelReloadPaths.push_back(pathStr);
@@ -470,7 +837,10 @@ bool Project::AssetManager::pollWatch()
     if (entry->type == FileType::IMAGE || entry->type == FileType::PREFAB) {
       reloadEntry(*entry, entry->path);
       if (entry->type == FileType::PREFAB && entry->prefab) {
+        auto pos = pathMap[getPathKey(entry->path)];
+        unindexEntry(*entry, pos.first, pos.second);
         entry->conf.uuid = entry->prefab->uuid.value;
+        indexEntry(*entry, pos.first, pos.second);
       }
     }
   };
@@ -483,8 +853,7 @@ bool Project::AssetManager::pollWatch()
     }
 
     removeEntryByPath(pathStr);
-    entries[static_cast<int>(newEntry.type)].push_back(std::move(newEntry));
-    touchedTypes.insert(static_cast<int>(newEntry.type));
+    insertEntry(std::move(newEntry));
   };
 
   // Add or update all the assets and scripts that were found
@@ -509,27 +878,6 @@ bool Project::AssetManager::pollWatch()
     }
   }
 
-  //sort by name
-  for (size_t typeIdx = 0; typeIdx < entries.size(); ++typeIdx) {
-    if (touchedTypes.find(static_cast<int>(typeIdx)) == touchedTypes.end()) {
-      continue;
-    }
-    auto &typed = entries[typeIdx];
-    std::sort(typed.begin(), typed.end(), [](const AssetManagerEntry &a, const AssetManagerEntry &b) {
-      return a.name < b.name;
-    });
-  }
-
-  // Rebuild UUID lookup after edits
-  entriesMap.clear();
-  for (auto &typed : entries) {
-    int idx = 0;
-    for (auto &entry : typed) {
-      entriesMap[entry.getUUID()] = {(int)entry.type, idx};
-      ++idx;
-    }
-  }
-
   // Update watcher snapshot for next poll
   watchFiles = std::move(currentFiles);
   return true;
@@ -563,11 +911,9 @@ void Project::AssetManager::save()
 
       auto oldFile = Utils::FS::loadTextFile(pathMeta);
 
-      // if the meta-data changed, force a recompile of the asset by deleting the target
+      // no need to touch the output here, the build-cache detects changed settings itself
       if (oldFile == json)continue;
-      Utils::Logger::log("Asset meta-data changed, forcing recompile: " + entry.outPath, Utils::Logger::LEVEL_INFO);
-      fs::remove(project->getPath() + "/" + entry.outPath);
-      Utils::FS::saveTextFile(pathMeta, entry.conf.serialize());
+      Utils::FS::saveTextFile(pathMeta, json);
     }
   }
 }
@@ -636,15 +982,26 @@ uint64_t Project::AssetManager::createNodeGraph(const std::string &name)
   return entry ? entry->getUUID() : 0;
 }
 
-Project::AssetManagerEntry *Project::AssetManager::getByPath(const std::string &path)
+Project::AssetManagerEntry *Project::AssetManager::getByName(const std::string &name)
 {
-  fs::path pathIn{path};
-  for (auto &typed : entries) {
-    for (auto &entry : typed) {
-      if (fs::path{entry.path} == pathIn) {
-        return &entry;
-      }
+  auto it = nameMap.find(name);
+  if (it == nameMap.end())return nullptr;
+
+  // same file name in different directories, pick the first one in list order
+  std::pair<int, int> bestPos{INT_MAX, INT_MAX};
+  for (const auto &key : it->second) {
+    auto itPath = pathMap.find(key);
+    if (itPath != pathMap.end() && itPath->second < bestPos) {
+      bestPos = itPath->second;
     }
   }
-  return nullptr;
-}
\ No newline at end of file
+  if (bestPos.first == INT_MAX)return nullptr;
+  return &entries[bestPos.first][bestPos.second];
+}
+
+Project::AssetManagerEntry *Project::AssetManager::getByPath(const std::string &path)
+{
+  auto it = pathMap.find(getPathKey(path));
+  if (it == pathMap.end())return nullptr;
+  return &entries[it->second.first][it->second.second];
+}
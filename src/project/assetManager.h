@@ -3,6 +3,9 @@
 * @license MIT
 */
 #pragma once
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,6 +15,8 @@
 #include "../renderer/object.h"
 #include "../utils/codeParser.h"
 #include "../renderer/texture.h"
+#include "../utils/fileWatcher.h"
+#include "../utils/workerPool.h"
 #include "scene/prefab.h"
 #include "tiny3d/tools/gltf_importer/src/structs.h"
 
@@ -43,6 +48,13 @@ namespace Project
     _SIZE
   };
 
+  enum class LoadState : uint8_t
+  {
+    READY = 0, // fully loaded, or nothing to load
+    LOADING,   // queued for background loading
+    FAILED,
+  };
+
   struct AssetConf
   {
     uint64_t uuid{0};
@@ -50,6 +62,8 @@ namespace Project
     int baseScale{0};
     bool gltfBVH{0};
     PROP_BOOL(gltfCollision);
+    PROP_BOOL(gltfCollEdges);
+    PROP_S32(bciQuality);
 
     ComprTypes compression{ComprTypes::DEFAULT};
     bool exclude{false};
@@ -77,6 +91,7 @@ namespace Project
     std::shared_ptr<Prefab> prefab{nullptr};
     AssetConf conf{};
     Utils::CPP::Struct params{};
+    LoadState loadState{LoadState::READY};
 
     uint64_t getUUID() const { return conf.uuid; }
 
@@ -94,11 +109,53 @@ namespace Project
       std::unordered_map<std::string, uint64_t> watchFiles{};
       std::chrono::steady_clock::time_point watchLastCheck{};
       bool watchInitialized{false};
+      Utils::FileWatcher watcher{};
+
+      // data decoded by a worker thread, waiting to be uploaded on the main thread
+      struct LoadResult
+      {
+        std::string path{};
+        uint32_t generation{0};
+        FileType type{};
+        bool success{false};
+        Renderer::Texture::Image image{};
+        T3DM::T3DMData t3dmData{};
+      };
+
+      Utils::WorkerPool loadPool{};
+      Utils::WorkerPool modelPool{1}; // glTF parsing, the importer only handles one file at a time
+      std::mutex mtxLoad{};
+      std::vector<LoadResult> loadResults{}; // written by workers, guarded by 'mtxLoad'
+      std::deque<LoadResult> loadApply{};
+      std::vector<LoadResult> loadDeferred{}; // models waiting for their textures
+      std::atomic_uint32_t loadGeneration{0};
+      uint32_t loadTotal{0};
+      uint32_t loadPending{0};
+      uint32_t loadPendingTex{0};
 
       std::string defaultScript{};
       std::shared_ptr<Renderer::Texture> fallbackTex{};
 
       void reloadEntry(AssetManagerEntry &entry, const std::string &path);
+      void queueLoad(AssetManagerEntry &entry);
+      void applyLoad(LoadResult &res);
+      void finishLoads(bool blocking);
+
+      bool pollScan();
+      bool applyWatchEvents(const std::vector<Utils::FileWatcher::Event> &events);
+
+      // secondary lookups, entries are identified by their normalized path
+      std::unordered_map<std::string, std::pair<int, int>> pathMap{};
+      std::unordered_map<std::string, std::vector<std::string>> nameMap{};
+
+      static std::string getPathKey(const std::string &path);
+      void indexEntry(const AssetManagerEntry &entry, int type, int idx);
+      void unindexEntry(const AssetManagerEntry &entry, int type, int idx);
+      void rebuildIndex();
+
+      void reindexEntries(int type, size_t startIdx);
+      AssetManagerEntry* insertEntry(AssetManagerEntry &&entry);
+      void removeEntry(int type, size_t idx);
     public:
       std::unordered_map<uint64_t, std::pair<int, int>> entriesMap{};
       //std::unordered_map<uint64_t, int> entriesMapScript{};
@@ -106,10 +163,25 @@ namespace Project
       explicit AssetManager(Project *pr);
       ~AssetManager();
 
+      /**
+       * Rescans all assets and scripts.
+       * Once this returns all entries exist, but textures and models may still be loading
+       * in the background (see 'LoadState'), unless running without a window.
+       */
       void reload();
       void reloadAssetByUUID(uint64_t uuid);
       bool pollWatch();
 
+      /**
+       * Per-frame update, uploads finished background loads and checks for file changes.
+       * Must be called from the main thread.
+       */
+      void update();
+
+      [[nodiscard]] bool isLoading() const { return loadPending > 0; }
+      [[nodiscard]] uint32_t getLoadTotal() const { return loadTotal; }
+      [[nodiscard]] uint32_t getLoadPending() const { return loadPending; }
+
       [[nodiscard]] const auto& getEntries() const {
         return entries;
       }
@@ -117,17 +189,14 @@ namespace Project
         return entries[static_cast<int>(type)];
       }
 
-      AssetManagerEntry* getByName(const std::string &name) {
-        for (auto &typed : entries) {
-          for (auto &entry : typed) {
-            if (entry.name == name) {
-              return &entry;
-            }
-          }
-        }
-        return nullptr;
-      }
+      /**
+       * Returns the first entry with the given file name (types in order, then sorted by name).
+       */
+      AssetManagerEntry* getByName(const std::string &name);
 
+      /**
+       * Returns the entry for a source file, the path is normalized before the lookup.
+       */
       AssetManagerEntry* getByPath(const std::string &path);
 
       AssetManagerEntry* getEntryByUUID(uint64_t uuid) {
@@ -3,6 +3,7 @@
 * @license MIT
 */
 #include "collision.h"
+#include "../../utils/binaryFile.h"
 
 #include "bvh/v2/bvh.h"
 #include "bvh/v2/vec.h"
@@ -10,7 +11,13 @@
 #include "bvh/v2/node.h"
 #include "bvh/v2/default_builder.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
 #include <vector>
+#include "glm/geometric.hpp"
 
 using Scalar  = double;
 using BVec3   = bvh::v2::Vec<Scalar, 3>;
@@ -20,70 +27,136 @@ using Bvh     = bvh::v2::Bvh<Node>;
 
 namespace
 {
-  void writeBVHNode(std::vector<int16_t> &out, Node &node, int nodeIndex) {
-    // 'bounds' layout is [min_x, max_x, min_y, max_y, min_z, max_z]
-    // we need min/max as separate vectors
-    int16_t offset = 1;
+  constexpr int QUANT_SHIFT = 8;
+  constexpr int NODE_SIZE = 5; // in int16, must match 'BVHNode' in the engine
 
-    glm::i16vec3 min{
-      (int16_t)round(node.bounds[0]) - offset,
-      (int16_t)round(node.bounds[2]) - offset,
-      (int16_t)round(node.bounds[4]) - offset
-    };
-    glm::i16vec3 max{
-      (int16_t)round(node.bounds[1]) + offset,
-      (int16_t)round(node.bounds[3]) + offset,
-      (int16_t)round(node.bounds[5]) + offset
+  // must match 'P64::Coll::Mesh' in the engine
+  constexpr uint32_t MESH_VERSION = 0x434C0002; // "CL" + layout version
+  constexpr uint32_t MESH_FLAG_EDGE_NORMALS = 1 << 0;
+
+  using PackedNormal = std::array<int16_t, 3>;
+
+  PackedNormal packNormal(const glm::vec3 &normal)
+  {
+    return {
+      (int16_t)(normal[0] * 32767.0f),
+      (int16_t)(normal[1] * 32767.0f),
+      (int16_t)(normal[2] * 32767.0f)
     };
+  }
+
+  struct IBox {
+    glm::ivec3 min{};
+    glm::ivec3 max{};
+  };
 
+  // node bounds on integer coordinates, always covering the original bounds
+  IBox getPaddedBounds(const Node &node)
+  {
+    // 'bounds' layout is [min_x, max_x, min_y, max_y, min_z, max_z]
+    IBox res{};
     for(int i=0; i<3; ++i) {
-      int diff = max[i] - min[i];
-      if(diff < 8) {
-        min[i] -= 4;
-        max[i] += 4;
+      res.min[i] = (int)floor(node.bounds[i*2]) - 1;
+      res.max[i] = (int)ceil(node.bounds[i*2+1]) + 1;
+      if(res.max[i] - res.min[i] < 8) {
+        res.min[i] -= 4;
+        res.max[i] += 4;
       }
     }
+    return res;
+  }
+
+  /**
+   * Bounds of all nodes, with each one extended to contain its children.
+   * This is needed since the padding above can make a child bigger than its parent,
+   * which can't be represented with relative bounds.
+   */
+  IBox calcBounds(const Bvh &bvh, size_t nodeIndex, std::vector<IBox> &bounds)
+  {
+    auto &node = bvh.nodes[nodeIndex];
+    auto res = getPaddedBounds(node);
+    int dataCount = node.index.value & 0b1111;
+    if(dataCount == 0) {
+      size_t firstChild = node.index.value >> 4;
+      for(size_t c=firstChild; c<firstChild+2; ++c) {
+        auto child = calcBounds(bvh, c, bounds);
+        for(int i=0; i<3; ++i) {
+          res.min[i] = std::min(res.min[i], child.min[i]);
+          res.max[i] = std::max(res.max[i], child.max[i]);
+        }
+      }
+    }
+    bounds[nodeIndex] = res;
+    return res;
+  }
+
+  /**
+   * Writes a node with its bounds quantized relative to its parent, rounding outwards.
+   * Children are relative to the bounds the runtime decodes, not the original ones.
+   * Must match 'BVHNode::decode' in the engine.
+   */
+  void writeBVHNode(
+    std::vector<int16_t> &out, const Bvh &bvh, const std::vector<IBox> &bounds,
+    size_t nodeIndex, const IBox &parent
+  ) {
+    auto &node = bvh.nodes[nodeIndex];
+    auto &child = bounds[nodeIndex];
 
-    out.push_back(min.x);
-    out.push_back(min.y);
-    out.push_back(min.z);
-    out.push_back(max.x);
-    out.push_back(max.y);
-    out.push_back(max.z);
+    uint8_t qMin[3], qMax[3];
+    IBox decoded{};
+    for(int i=0; i<3; ++i) {
+      int size = parent.max[i] - parent.min[i]; // never zero due to the padding
+      qMin[i] = std::min(((child.min[i] - parent.min[i]) << QUANT_SHIFT) / size, 255);
+      qMax[i] = std::min(((parent.max[i] - child.max[i]) << QUANT_SHIFT) / size, 255);
+      decoded.min[i] = parent.min[i] + ((qMin[i] * size) >> QUANT_SHIFT);
+      decoded.max[i] = parent.max[i] - ((qMax[i] * size) >> QUANT_SHIFT);
+      assert(decoded.min[i] <= child.min[i] && decoded.max[i] >= child.max[i]);
+    }
 
     int dataCount = node.index.value & 0b1111;
     int dataOffset = node.index.value >> 4;
+    if(dataOffset > 0xFFFF) {
+      throw std::runtime_error("Collision mesh too large, BVH offset: " + std::to_string(dataOffset));
+    }
 
-    if(dataCount == 0) {
-      int indexDiff = dataOffset - nodeIndex;
+    // written as big-endian, so this results in the bytes: min. XYZ, max. XYZ
+    auto nodeOut = &out[out.size() - bvh.nodes.size() * NODE_SIZE + nodeIndex * NODE_SIZE];
+    nodeOut[0] = (int16_t)((qMin[0] << 8) | qMin[1]);
+    nodeOut[1] = (int16_t)((qMin[2] << 8) | qMax[0]);
+    nodeOut[2] = (int16_t)((qMax[1] << 8) | qMax[2]);
+    nodeOut[3] = (int16_t)dataCount;
+    nodeOut[4] = (int16_t)dataOffset;
 
-      int16_t packedVal = (int16_t)(indexDiff << 4);
-      if((packedVal >> 4) != indexDiff) {
-        printf("Error: indexDiff %d (%d - %d) does not fit in 12 bits\n", indexDiff, dataOffset, nodeIndex);
-        throw;
-      }
-      //assert((packedVal >> 4) == indexDiff);
-      out.push_back(packedVal);
-    } else {
-      out.push_back(node.index.value);
+    if(dataCount == 0) {
+      writeBVHNode(out, bvh, bounds, dataOffset, decoded);
+      writeBVHNode(out, bvh, bounds, dataOffset + 1, decoded);
     }
   }
 
-  void writeBVH(std::vector<int16_t> &out, Bvh &bvh) {
-    out.push_back(bvh.nodes.size());
-    out.push_back(bvh.prim_ids.size());
-    int nodeIndex = 0;
-    for(auto& node : bvh.nodes) {
-      writeBVHNode(out, node, nodeIndex++);
+  void writeBVH(std::vector<int16_t> &out, const Bvh &bvh)
+  {
+    std::vector<IBox> bounds(bvh.nodes.size());
+    auto rootBounds = calcBounds(bvh, 0, bounds);
+
+    for(int i=0; i<3; ++i) {
+      if(rootBounds.min[i] < INT16_MIN || rootBounds.max[i] > INT16_MAX) {
+        throw std::runtime_error("Collision mesh too large, exceeds the range of 16-bit coordinates");
+      }
     }
-    for(auto&& prim_id : bvh.prim_ids) {
-      out.push_back(prim_id);
+    for(int i=0; i<3; ++i)out.push_back((int16_t)rootBounds.min[i]);
+    for(int i=0; i<3; ++i)out.push_back((int16_t)rootBounds.max[i]);
+
+    if(bvh.nodes.size() > 0xFFFF) {
+      throw std::runtime_error("Collision mesh too large, BVH node count: " + std::to_string(bvh.nodes.size()));
     }
+    out.push_back((int16_t)bvh.nodes.size());
+    out.resize(out.size() + bvh.nodes.size() * NODE_SIZE);
+    writeBVHNode(out, bvh, bounds, 0, rootBounds);
   }
 }
 
-std::vector<int16_t> Project::Assets::Collision::createBVH(
-  const std::vector<glm::i16vec3> &vertices,
+Project::Assets::Collision::BVHData Project::Assets::Collision::createBVH(
+  const std::vector<glm::vec3> &vertices,
   const std::vector<uint16_t> &indices
 ) {
   std::vector<BBox> aabbs;
@@ -102,12 +175,139 @@ std::vector<int16_t> Project::Assets::Collision::createBVH(
     centers.push_back(aabb.get_center());
   }
 
+  BVHData res{};
+  if(aabbs.empty()) {
+    res.data = {0, 0, 0, 0, 0, 0, 0};
+    return res;
+  }
+
   bvh::v2::ThreadPool thread_pool;
   typename bvh::v2::DefaultBuilder<Node>::Config config;
   config.quality = bvh::v2::DefaultBuilder<Node>::Quality::High;
   auto bvh = bvh::v2::DefaultBuilder<Node>::build(thread_pool, aabbs, centers, config);
 
-  std::vector<int16_t> treeData;
-  writeBVH(treeData, bvh);
-  return treeData;
+  writeBVH(res.data, bvh);
+  res.triOrder.assign(bvh.prim_ids.begin(), bvh.prim_ids.end());
+  return res;
+}
+
+void Project::Assets::Collision::writeMesh(
+  Utils::BinaryFile &file,
+  const std::vector<glm::vec3> &verticesFloat,
+  const std::vector<uint16_t> &indices,
+  bool withEdgeNormals
+) {
+  std::vector<PackedNormal> normals{};
+  std::vector<PackedNormal> edgeNormals{};
+
+  // generate normals
+  for(uint32_t v=0; v<indices.size(); v+=3) {
+    glm::vec3 edge1 = verticesFloat[indices[v+1]] - verticesFloat[indices[v]];
+    glm::vec3 edge2 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
+    glm::vec3 edge3 = verticesFloat[indices[v+2]] - verticesFloat[indices[v]];
+
+    if(glm::length(edge1) < 0.01f || glm::length(edge2) < 0.01f || glm::length(edge3) < 0.01f) {
+      printf("Degenerate triangle:\nA: %.4f %.4f %.4f\nB: %.4f %.4f %.4f\nC: %.4f %.4f %.4f\n",
+        verticesFloat[indices[v]][0], verticesFloat[indices[v]][1], verticesFloat[indices[v]][2],
+        verticesFloat[indices[v+1]][0], verticesFloat[indices[v+1]][1], verticesFloat[indices[v+1]][2],
+        verticesFloat[indices[v+2]][0], verticesFloat[indices[v+2]][1], verticesFloat[indices[v+2]][2]
+      );
+      printf("Indices: %d %d %d\n", indices[v], indices[v+1], indices[v+2]);
+      throw std::runtime_error("Degenerate triangle!");
+    }
+
+    glm::vec3 normal = glm::cross(edge1, edge2);
+    normal = normal * (1.0f / glm::length(normal));
+    normals.push_back(packNormal(normal));
+
+    // planes through each edge (A->B, B->C, C->A) facing inwards,
+    // the runtime uses them to check on which side of an edge a point is
+    if(withEdgeNormals) {
+      for(int e=0; e<3; ++e) {
+        glm::vec3 edge = verticesFloat[indices[v + (e+1) % 3]] - verticesFloat[indices[v + e]];
+        glm::vec3 edgeNormal = glm::cross(normal, edge);
+        edgeNormals.push_back(packNormal(edgeNormal * (1.0f / glm::length(edgeNormal))));
+      }
+    }
+  }
+
+  assert(indices.size() % 3 == 0);
+
+  // Vertices are stored as 16-bit integers, scaled by a power of two to use as much of the range as possible.
+  // The BVH is created from the quantized positions, so it matches what the runtime sees.
+  float maxAbs = 1.0f;
+  for(auto &v : verticesFloat) {
+    for(int i=0; i<3; ++i)maxAbs = fmaxf(maxAbs, fabsf(v[i]));
+  }
+  float collScale = exp2f(ceilf(log2f(maxAbs / 32767.0f)));
+
+  std::vector<glm::vec3> verticesQuant{};
+  verticesQuant.reserve(verticesFloat.size());
+  for(auto &v : verticesFloat) {
+    verticesQuant.push_back({
+      roundf(v[0] / collScale) * collScale,
+      roundf(v[1] / collScale) * collScale,
+      roundf(v[2] / collScale) * collScale,
+    });
+  }
+
+  auto bvh = createBVH(verticesQuant, indices);
+
+  // BVH leaf-nodes reference ranges of triangles, so they need to be in the same order.
+  // Vertices are then sorted by first use, which keeps the data of nearby triangles close together.
+  uint32_t triCount = indices.size() / 3;
+  std::vector<uint16_t> indicesSorted{};
+  std::vector<PackedNormal> normalsSorted{};
+  std::vector<PackedNormal> edgeNormalsSorted{};
+  std::vector<glm::vec3> vertsSorted{};
+  std::vector<int> vertRemap(verticesQuant.size(), -1);
+
+  for(uint32_t t : bvh.triOrder) {
+    for(int i=0; i<3; ++i) {
+      auto idx = indices[t*3 + i];
+      if(vertRemap[idx] < 0) {
+        vertRemap[idx] = vertsSorted.size();
+        vertsSorted.push_back(verticesQuant[idx]);
+      }
+      indicesSorted.push_back(vertRemap[idx]);
+    }
+    normalsSorted.push_back(normals[t]);
+    if(withEdgeNormals) {
+      for(int e=0; e<3; ++e)edgeNormalsSorted.push_back(edgeNormals[t*3 + e]);
+    }
+  }
+  assert(indicesSorted.size() == indices.size());
+
+  file.write<uint32_t>(MESH_VERSION);
+  file.write<uint32_t>(triCount);
+  file.write<uint32_t>(vertsSorted.size());
+  file.write<float>(collScale);
+  file.write<uint32_t>(withEdgeNormals ? MESH_FLAG_EDGE_NORMALS : 0);
+  file.write<uint32_t>(0); // vertex pointer
+  file.write<uint32_t>(0); // normals pointer
+  file.write<uint32_t>(0); // edge-normals pointer
+  file.write<uint32_t>(0); // BVH pointer
+
+  file.writeArray(indicesSorted.data(), indicesSorted.size());
+  file.align(4);
+
+  for(auto& n : normalsSorted) {
+    file.writeArray(n.data(), n.size());
+  }
+  file.align(4);
+
+  for(auto& n : edgeNormalsSorted) {
+    file.writeArray(n.data(), n.size());
+  }
+  file.align(4);
+
+  for(auto& v : vertsSorted) {
+    file.write((int16_t)roundf(v.x / collScale));
+    file.write((int16_t)roundf(v.y / collScale));
+    file.write((int16_t)roundf(v.z / collScale));
+  }
+  file.align(4);
+
+  file.writeArray(bvh.data.data(), bvh.data.size());
+  file.align(4);
 }
@@ -7,10 +7,38 @@
 #include <vector>
 #include "glm/vec3.hpp"
 
+namespace Utils
+{
+  class BinaryFile;
+}
+
 namespace Project::Assets::Collision
 {
-  std::vector<int16_t> createBVH(
-    const std::vector<glm::i16vec3> &vertices,
+  struct BVHData
+  {
+    std::vector<int16_t> data{}; // root bounds, node count and nodes, as read by the runtime
+    std::vector<uint32_t> triOrder{}; // original triangle index for each triangle the leaf-nodes reference
+  };
+
+  /**
+   * Creates a BVH over all triangles, nodes store their bounds relative to the parent.
+   * Leaf-nodes reference ranges of triangles, so the triangles must be reordered by 'triOrder'.
+   */
+  BVHData createBVH(
+    const std::vector<glm::vec3> &vertices,
     const std::vector<uint16_t> &indices
   );
+
+  /**
+   * Writes a triangle mesh in the runtime collision format ('P64::Coll::Mesh'), including its BVH.
+   * Vertices are quantized to 16-bit, triangles are sorted by the BVH and vertices by first use.
+   * With 'withEdgeNormals' set, each triangle also stores its edge-planes.
+   * @throws std::runtime_error for degenerate triangles or meshes too large for the BVH
+   */
+  void writeMesh(
+    Utils::BinaryFile &file,
+    const std::vector<glm::vec3> &verticesFloat,
+    const std::vector<uint16_t> &indices,
+    bool withEdgeNormals
+  );
 }
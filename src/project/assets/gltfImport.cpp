@@ -0,0 +1,22 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "gltfImport.h"
+
+namespace
+{
+  std::mutex mtxImporter{};
+}
+
+Project::Assets::GLTF::ImportLock::ImportLock(const Config &conf)
+  : lock{mtxImporter}
+{
+  T3DM::config = conf;
+}
+
+T3DM::T3DMData Project::Assets::GLTF::parse(const std::string &path, const Config &conf)
+{
+  ImportLock importLock{conf};
+  return T3DM::parseGLTF(path.c_str());
+}
@@ -0,0 +1,36 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include "tiny3d/tools/gltf_importer/src/parser.h"
+
+namespace Project::Assets::GLTF
+{
+  // the tiny3d importer reads its settings from a global
+  using Config = std::remove_cvref_t<decltype(T3DM::config)>;
+
+  /**
+   * Exclusive access to the glTF importer with the given settings.
+   * Must be held for the whole time any importer/writer function is used,
+   * since they all read from the global 'T3DM::config'.
+   * This means only one glTF file can be parsed at a time, no matter how many threads try to.
+   */
+  class ImportLock
+  {
+    private:
+      std::unique_lock<std::mutex> lock;
+
+    public:
+      explicit ImportLock(const Config &conf);
+  };
+
+  /**
+   * Thread-safe version of 'T3DM::parseGLTF', taking the settings per call.
+   * @throws std::exception if the file could not be parsed
+   */
+  T3DM::T3DMData parse(const std::string &path, const Config &conf);
+}
@@ -0,0 +1,275 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "modelCache.h"
+
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "json.hpp"
+#include "../../utils/fs.h"
+#include "../../utils/hash.h"
+#include "../../utils/proc.h"
+
+namespace
+{
+  constexpr uint32_t CACHE_MAGIC = 0x50364D43; // "P6MC"
+  constexpr uint32_t CACHE_VERSION = 2; // bump on any change to the layout below or the key
+
+  // The importer is compiled into the editor, so any change to it results in a different binary
+  const std::string &getImporterId()
+  {
+    static const std::string id = []
+    {
+      auto selfPath = Utils::Proc::getSelfPath();
+      std::error_code ecTime{}, ecSize{};
+      auto time = fs::last_write_time(selfPath, ecTime).time_since_epoch().count();
+      auto size = fs::file_size(selfPath, ecSize);
+      return std::format("{}:{}", (ecSize ? 0 : size), (ecTime ? 0 : time));
+    }();
+    return id;
+  }
+
+  std::string decodeUri(const std::string &uri)
+  {
+    std::string res{};
+    for(size_t i=0; i<uri.size(); ++i) {
+      uint8_t c{};
+      if(uri[i] == '%' && i+2 < uri.size()
+        && std::from_chars(uri.data() + i + 1, uri.data() + i + 3, c, 16).ptr == uri.data() + i + 3)
+      {
+        res += (char)c;
+        i += 2;
+      } else {
+        res += uri[i];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * Files a glTF references by URI (external buffers and images), relative to the model.
+   * Embedded data ('data:' URIs, .glb binary chunk) is already part of the source itself.
+   */
+  std::vector<fs::path> getExternalFiles(const fs::path &srcPath, const std::string &src)
+  {
+    // .glb: 12-byte header, followed by the JSON chunk (length, type, data)
+    std::string_view jsonText{src};
+    if(src.size() >= 20 && src.starts_with("glTF")) {
+      uint32_t chunkSize{};
+      memcpy(&chunkSize, src.data() + 12, sizeof(chunkSize));
+      jsonText = jsonText.substr(20, chunkSize);
+    }
+
+    auto json = nlohmann::json::parse(jsonText.begin(), jsonText.end(), nullptr, false);
+    if(!json.is_object())return {};
+
+    std::vector<fs::path> res{};
+    for(auto key : {"buffers", "images"}) {
+      auto entries = json.find(key);
+      if(entries == json.end() || !entries->is_array())continue;
+
+      for(auto &entry : *entries) {
+        if(!entry.is_object() || !entry.contains("uri") || !entry["uri"].is_string())continue;
+        auto uri = entry["uri"].get<std::string>();
+        if(uri.starts_with("data:"))continue;
+        res.push_back(srcPath.parent_path() / decodeUri(uri));
+      }
+    }
+    return res;
+  }
+
+  // Flat little-endian layout, strings are length-prefixed.
+  // Written and read by the same visitor functions, so both sides can't get out of sync.
+  struct Writer
+  {
+    std::string data{};
+
+    template<typename T>
+    void operator()(const T &value) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void operator()(const std::string &str) {
+      (*this)((uint32_t)str.size());
+      data.append(str);
+    }
+  };
+
+  struct Reader
+  {
+    const std::string &data;
+    size_t pos{0};
+
+    void check(size_t size) const {
+      if(pos + size > data.size())throw std::out_of_range("Model-cache truncated");
+    }
+
+    template<typename T>
+    void operator()(T &value) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      check(sizeof(T));
+      memcpy(&value, data.data() + pos, sizeof(T));
+      pos += sizeof(T);
+    }
+
+    void operator()(std::string &str) {
+      uint32_t size{};
+      (*this)(size);
+      check(size);
+      str.assign(data.data() + pos, size);
+      pos += size;
+    }
+  };
+
+  template<typename IO, typename TileParam>
+  void visitTile(IO &io, TileParam &tile)
+  {
+    io(tile.mask);
+    io(tile.shift);
+    io(tile.low);
+    io(tile.high);
+    io(tile.clamp);
+    io(tile.mirror);
+  }
+
+  template<typename IO, typename Tex>
+  void visitTex(IO &io, Tex &tex)
+  {
+    io(tex.texPath);
+    visitTile(io, tex.s);
+    visitTile(io, tex.t);
+  }
+
+  template<typename IO, typename Material>
+  void visitMaterial(IO &io, Material &mat)
+  {
+    io(mat.name);
+    io(mat.colorCombiner);
+    io(mat.otherModeValue);
+    io(mat.drawFlags);
+    io(mat.vertexFxFunc);
+    io(mat.setBlendColor);
+    io(mat.setEnvColor);
+    io(mat.setPrimColor);
+    io(mat.primColor);
+    io(mat.envColor);
+    visitTex(io, mat.texA);
+    visitTex(io, mat.texB);
+  }
+
+  template<typename IO, typename Tri>
+  void visitTriangle(IO &io, Tri &tri)
+  {
+    for(auto &vert : tri.vert) {
+      io(vert.pos);
+      io(vert.norm);
+      io(vert.rgba);
+      io(vert.s);
+      io(vert.t);
+    }
+  }
+}
+
+uint64_t Project::Assets::ModelCache::getKey(const std::string &srcPath, const GLTF::Config &conf)
+{
+  auto src = Utils::FS::loadTextFile(srcPath);
+  if(src.empty())return 0;
+
+  // a .gltf may keep its geometry and textures in separate files, changes there must be a miss too
+  std::string depHashes{};
+  for(auto &dep : getExternalFiles(srcPath, src)) {
+    depHashes += std::format("{:016X},", Utils::Hash::sha256_64bit(Utils::FS::loadTextFile(dep)));
+  }
+
+  // texture paths in the result depend on the asset directory, so it's part of the key too
+  return Utils::Hash::sha256_64bit(std::format("{:016X}|{}|{}|{}|{}|{}|{}|{}",
+    Utils::Hash::sha256_64bit(src), depHashes,
+    conf.globalScale, conf.animSampleRate, conf.createBVH,
+    conf.assetPath, conf.assetPathFull,
+    getImporterId()
+  ));
+}
+
+bool Project::Assets::ModelCache::load(const fs::path &cachePath, uint64_t key, T3DM::T3DMData &data)
+{
+  if(key == 0)return false;
+  auto file = Utils::FS::loadTextFile(cachePath);
+  if(file.empty())return false;
+
+  try {
+    Reader io{file};
+    uint32_t magic{}, version{};
+    uint64_t fileKey{};
+    io(magic);
+    io(version);
+    io(fileKey);
+    if(magic != CACHE_MAGIC || version != CACHE_VERSION || fileKey != key)return false;
+
+    T3DM::T3DMData res{};
+    uint32_t modelCount{}, skeletonCount{}, animCount{};
+    io(modelCount);
+    io(skeletonCount);
+    io(animCount);
+
+    res.models.resize(modelCount);
+    for(auto &model : res.models) {
+      io(model.name);
+      visitMaterial(io, model.material);
+
+      uint32_t triCount{};
+      io(triCount);
+      io.check((size_t)triCount * 3); // avoid huge allocations from broken files
+      model.triangles.resize(triCount);
+      for(auto &tri : model.triangles) {
+        visitTriangle(io, tri);
+      }
+    }
+
+    res.skeletons.resize(skeletonCount);
+    res.animations.resize(animCount);
+    data = std::move(res);
+    return true;
+  } catch(const std::exception&) {
+    return false;
+  }
+}
+
+void Project::Assets::ModelCache::save(const fs::path &cachePath, uint64_t key, const T3DM::T3DMData &data)
+{
+  if(key == 0)return;
+
+  Writer io{};
+  io(CACHE_MAGIC);
+  io(CACHE_VERSION);
+  io(key);
+
+  io((uint32_t)data.models.size());
+  io((uint32_t)data.skeletons.size());
+  io((uint32_t)data.animations.size());
+
+  for(auto &model : data.models) {
+    io(model.name);
+    visitMaterial(io, model.material);
+
+    io((uint32_t)model.triangles.size());
+    for(auto &tri : model.triangles) {
+      visitTriangle(io, tri);
+    }
+  }
+
+  // write to a temporary file first, a parallel load must never see a partial file
+  std::error_code ec{};
+  fs::create_directories(cachePath.parent_path(), ec);
+  auto tmpPath = cachePath;
+  tmpPath += std::format(".{:08X}.tmp", Utils::Hash::randomU32());
+  Utils::FS::saveTextFile(tmpPath, io.data);
+  fs::rename(tmpPath, cachePath, ec);
+  if(ec)fs::remove(tmpPath, ec);
+}
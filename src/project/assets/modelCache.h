@@ -0,0 +1,31 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <filesystem>
+#include <string>
+#include "gltfImport.h"
+
+namespace fs = std::filesystem;
+
+namespace Project::Assets::ModelCache
+{
+  /**
+   * Returns the cache key for a model, combining the source content,
+   * the content of all files it references (buffers, images), all import settings, and the identity of the importer (part of the editor binary).
+   * Returns 0 if the source could not be read.
+   */
+  uint64_t getKey(const std::string &srcPath, const GLTF::Config &conf);
+
+  /**
+   * Loads a model from the cache, only succeeds if the stored key matches.
+   * Note that only the data the editor uses is cached (meshes, materials, vertices),
+   * skeletons and animations are only restored by count.
+   *
+   * @return true if loaded, false on a cache miss or invalid file
+   */
+  bool load(const fs::path &cachePath, uint64_t key, T3DM::T3DMData &data);
+
+  void save(const fs::path &cachePath, uint64_t key, const T3DM::T3DMData &data);
+}
@@ -9,6 +9,7 @@
 #include "json.hpp"
 #include "IconsMaterialDesignIcons.h"
 #include "../../build/sceneContext.h"
+#include "../../../n64/engine/include/scene/componentPrio.h"
 
 namespace Editor
 {
@@ -41,7 +42,7 @@ namespace Project::Component
   struct CompInfo
   {
     int id{};
-    int prio{};
+    int prio{}; // lower comes first, same values as the runtime ('P64::CompPrio')
     const char* icon{};
     const char* name{};
     FuncCompInit funcInit{};
@@ -160,7 +161,7 @@ namespace Project::Component
     },
     CompInfo{
       .id = 7,
-      .prio = -2, // constraint must come before culling and any drawing
+      .prio = P64::CompPrio::CONSTRAINT,
       .icon = ICON_MDI_LINK " ",
       .name = "Constraint",
       .funcInit = Constraint::init,
@@ -172,7 +173,7 @@ namespace Project::Component
     },
     CompInfo{
       .id = 8,
-      .prio = -1, // culling must come before any models
+      .prio = P64::CompPrio::CULLING,
       .icon = ICON_MDI_EYE_OFF_OUTLINE " ",
       .name = "Culling",
       .funcInit = Culling::init,
@@ -6,16 +6,14 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
 
 #include "SDL3_image/SDL_image.h"
 
 extern SDL_GPUSampler *texSamplerRepeat;
 
-Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
-  : gpuDevice(device)
+Renderer::Texture::Image Renderer::Texture::loadImage(const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
 {
-  if(!gpuDevice)return; // CLI mode
-
   SDL_Surface *imgRaw;
   if (imgPath.ends_with(".svg") && rasterWidth > 0 && rasterHeight > 0) {
     auto imgStream = SDL_IOFromFile(imgPath.c_str(), "rb");
@@ -23,8 +21,11 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   } else {
     imgRaw = IMG_Load(imgPath.c_str());
   }
+  if(!imgRaw)return {};
 
   auto img = SDL_ConvertSurface(imgRaw, SDL_PIXELFORMAT_BGRA32);
+  SDL_DestroySurface(imgRaw);
+  if(!img)return {};
 
   if(isMono)
   {
@@ -42,18 +43,49 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
     SDL_UnlockSurface(img);
   }
 
-  SDL_DestroySurface(imgRaw);
-
-  width = img->w;
-  height = img->h;
-  char* image_data = (char*)img->pixels;
+  Image res{
+    .width = img->w,
+    .height = img->h,
+  };
 
   //printf("Loaded %s: w/h: %dx%d, format: %s\n", imgPath.c_str(), width, height, SDL_GetPixelFormatName(img->format));
 
+  uint32_t rowSize = res.width * 4;
+  res.pixels.resize(rowSize * res.height);
+  for (int y = 0; y < res.height; y++) {
+    memcpy(res.pixels.data() + y * rowSize, (uint8_t*)img->pixels + y * img->pitch, rowSize);
+  }
+
+  SDL_DestroySurface(img);
+  return res;
+}
+
+Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono, int rasterWidth, int rasterHeight)
+  : gpuDevice(device)
+{
+  if(!gpuDevice)return; // CLI mode
+  upload(loadImage(imgPath, isMono, rasterWidth, rasterHeight));
+}
+
+Renderer::Texture::Texture(SDL_GPUDevice* device, const Image &img)
+  : gpuDevice(device)
+{
+  if(!gpuDevice)return; // CLI mode
+  upload(img);
+}
+
+void Renderer::Texture::upload(const Image &img)
+{
+  if(!img.isValid())return;
+
+  width = img.width;
+  height = img.height;
+  auto image_data = img.pixels.data();
+
   // Create texture
   SDL_GPUTextureCreateInfo texture_info = {};
   texture_info.type = SDL_GPU_TEXTURETYPE_2D;
-  texture_info.format = SDL_GetGPUTextureFormatFromPixelFormat(img->format);
+  texture_info.format = SDL_GetGPUTextureFormatFromPixelFormat(SDL_PIXELFORMAT_BGRA32);
   texture_info.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
   texture_info.width = width;
   texture_info.height = height;
@@ -61,22 +93,20 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   texture_info.num_levels = 1;
   texture_info.sample_count = SDL_GPU_SAMPLECOUNT_1;
 
-  texture = SDL_CreateGPUTexture(device, &texture_info);
+  texture = SDL_CreateGPUTexture(gpuDevice, &texture_info);
 
   // Create transfer buffer
   // FIXME: A real engine would likely keep one around, see what the SDL_GPU backend is doing.
   SDL_GPUTransferBufferCreateInfo transferbuffer_info = {};
   transferbuffer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
   transferbuffer_info.size = width * height * 4;
-  SDL_GPUTransferBuffer* transferbuffer = SDL_CreateGPUTransferBuffer(device, &transferbuffer_info);
+  SDL_GPUTransferBuffer* transferbuffer = SDL_CreateGPUTransferBuffer(gpuDevice, &transferbuffer_info);
   assert(transferbuffer != nullptr);
 
   // Copy to transfer buffer
-  uint32_t upload_pitch = width * 4;
-  void* texture_ptr = SDL_MapGPUTransferBuffer(device, transferbuffer, true);
-  for (int y = 0; y < height; y++)
-      memcpy((void*)((uintptr_t)texture_ptr + y * upload_pitch), image_data + y * upload_pitch, upload_pitch);
-  SDL_UnmapGPUTransferBuffer(device, transferbuffer);
+  void* texture_ptr = SDL_MapGPUTransferBuffer(gpuDevice, transferbuffer, true);
+  memcpy(texture_ptr, image_data, img.pixels.size());
+  SDL_UnmapGPUTransferBuffer(gpuDevice, transferbuffer);
 
   SDL_GPUTextureTransferInfo transfer_info = {};
   transfer_info.offset = 0;
@@ -90,22 +120,20 @@ Renderer::Texture::Texture(SDL_GPUDevice* device, const std::string &imgPath, bo
   texture_region.h = (Uint32)height;
   texture_region.d = 1;
 
-  SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(device);
+  SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(gpuDevice);
   SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
   SDL_UploadToGPUTexture(copy_pass, &transfer_info, &texture_region, false);
   SDL_EndGPUCopyPass(copy_pass);
   SDL_SubmitGPUCommandBuffer(cmd);
 
-  SDL_ReleaseGPUTransferBuffer(device, transferbuffer);
-
-  SDL_DestroySurface(img);
+  SDL_ReleaseGPUTransferBuffer(gpuDevice, transferbuffer);
 
   texBinding.texture = texture;
   texBinding.sampler = texSamplerRepeat;
 }
 
 Renderer::Texture::~Texture() {
- SDL_ReleaseGPUTexture(gpuDevice, texture);
+ if(texture)SDL_ReleaseGPUTexture(gpuDevice, texture);
 }
 
 void Renderer::Texture::bind(SDL_GPURenderPass* pass)
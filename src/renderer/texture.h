@@ -3,7 +3,9 @@
 * @license MIT
 */
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <SDL3/SDL_gpu.h>
 
 #include "imgui.h"
@@ -22,7 +24,24 @@ namespace Renderer
       int height{0};
 
     public:
+      // decoded image in CPU memory (BGRA32, no padding)
+      struct Image
+      {
+        int width{0};
+        int height{0};
+        std::vector<uint8_t> pixels{};
+
+        [[nodiscard]] bool isValid() const { return !pixels.empty(); }
+      };
+
+      /**
+       * Loads and decodes an image file without touching the GPU,
+       * this is safe to call from any thread.
+       */
+      static Image loadImage(const std::string &imgPath, bool isMono = false, int rasterWidth = 0, int rasterHeight = 0);
+
       Texture(SDL_GPUDevice* device, const std::string &imgPath, bool isMono = false, int rasterWidth = 0, int rasterHeight = 0);
+      Texture(SDL_GPUDevice* device, const Image &img);
       ~Texture();
 
       [[nodiscard]] int getWidth() const { return width; };
@@ -34,5 +53,8 @@ namespace Renderer
       };
 
       void bind(SDL_GPURenderPass* pass);
+
+    private:
+      void upload(const Image &img);
   };
 }
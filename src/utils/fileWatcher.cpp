@@ -0,0 +1,221 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "fileWatcher.h"
+
+#include <algorithm>
+#include "logger.h"
+
+#if defined(__linux__)
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace
+{
+  #if defined(__linux__)
+    constexpr uint32_t WATCH_MASK = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE
+      | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+    // timeout to re-check if the thread should stop
+    constexpr int POLL_TIMEOUT_MS = 100;
+  #endif
+}
+
+bool Utils::FileWatcher::start(const std::vector<fs::path> &dirs)
+{
+  stop();
+
+  #if defined(__linux__)
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(fd < 0) {
+      Utils::Logger::log("File-watcher not available, falling back to polling", Utils::Logger::LEVEL_WARN);
+      return false;
+    }
+
+    for(auto &dir : dirs) {
+      if(fs::is_directory(dir))addWatchRecursive(dir, false);
+    }
+
+    if(watchDirs.empty()) {
+      stop();
+      return false;
+    }
+
+    running = true;
+    thread = std::thread(&FileWatcher::threadMain, this);
+    return true;
+  #else
+    (void)dirs;
+    return false;
+  #endif
+}
+
+void Utils::FileWatcher::stop()
+{
+  running = false;
+  if(thread.joinable())thread.join();
+
+  #if defined(__linux__)
+    if(fd >= 0)close(fd); // also removes all watches
+  #endif
+
+  fd = -1;
+  watchDirs.clear();
+
+  std::lock_guard lock{mtx};
+  pending.clear();
+  overflow = false;
+}
+
+void Utils::FileWatcher::addWatchRecursive(const fs::path &dir, bool emitFiles)
+{
+  #if defined(__linux__)
+    int wd = inotify_add_watch(fd, dir.c_str(), WATCH_MASK);
+    if(wd < 0) {
+      Utils::Logger::log("Failed to watch directory: " + dir.string(), Utils::Logger::LEVEL_WARN);
+      return;
+    }
+    watchDirs[wd] = dir.string();
+
+    // a new directory may already contain files before the watch was added
+    std::error_code ec{};
+    for(auto &entry : fs::directory_iterator{dir, ec}) {
+      if(entry.is_directory(ec)) {
+        addWatchRecursive(entry.path(), emitFiles);
+      } else if(emitFiles && entry.is_regular_file(ec)) {
+        pushEvent(entry.path().string(), EventType::CREATED, false);
+      }
+    }
+  #else
+    (void)dir; (void)emitFiles;
+  #endif
+}
+
+void Utils::FileWatcher::pushEvent(const std::string &path, EventType type, bool isDir)
+{
+  std::lock_guard lock{mtx};
+  lastEventTime = std::chrono::steady_clock::now();
+
+  auto it = pending.find(path);
+  if(it == pending.end()) {
+    pending[path] = {type, isDir, eventOrder++};
+    return;
+  }
+
+  // merge with the previous event, only the final state matters
+  auto &ev = it->second;
+  ev.isDir |= isDir;
+  if(type == EventType::DELETED) {
+    ev.type = EventType::DELETED;
+  } else if(ev.type == EventType::DELETED) {
+    ev.type = EventType::MODIFIED; // replaced
+  }
+}
+
+void Utils::FileWatcher::threadMain()
+{
+  #if defined(__linux__)
+    alignas(inotify_event) char buff[16 * 1024];
+    pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+
+    while(running)
+    {
+      if(poll(&pfd, 1, POLL_TIMEOUT_MS) <= 0)continue;
+
+      for(;;)
+      {
+        auto len = read(fd, buff, sizeof(buff));
+        if(len <= 0)break; // EAGAIN, all events read
+
+        for(char *ptr = buff; ptr < buff + len;)
+        {
+          auto ev = reinterpret_cast<const inotify_event*>(ptr);
+          ptr += sizeof(inotify_event) + ev->len;
+
+          if(ev->mask & IN_Q_OVERFLOW) {
+            std::lock_guard lock{mtx};
+            overflow = true;
+            lastEventTime = std::chrono::steady_clock::now();
+            continue;
+          }
+
+          if(ev->mask & IN_IGNORED) {
+            watchDirs.erase(ev->wd);
+            continue;
+          }
+
+          auto itDir = watchDirs.find(ev->wd);
+          if(itDir == watchDirs.end() || ev->len == 0)continue;
+
+          auto path = itDir->second + "/" + ev->name;
+          bool isDir = ev->mask & IN_ISDIR;
+
+          if(isDir)
+          {
+            if(ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+              addWatchRecursive(path, true);
+            }
+            else if(ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+              // watches of moved directories stay valid, drop them so paths don't get stale
+              auto prefix = path + "/";
+              for(auto it = watchDirs.begin(); it != watchDirs.end();) {
+                if(it->second == path || it->second.starts_with(prefix)) {
+                  inotify_rm_watch(fd, it->first);
+                  it = watchDirs.erase(it);
+                } else {
+                  ++it;
+                }
+              }
+              pushEvent(path, EventType::DELETED, true);
+            }
+            continue;
+          }
+
+          if(ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+            pushEvent(path, EventType::CREATED, false);
+          } else if(ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+            pushEvent(path, EventType::DELETED, false);
+          } else if(ev->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+            pushEvent(path, EventType::MODIFIED, false);
+          }
+        }
+      }
+    }
+  #endif
+}
+
+std::vector<Utils::FileWatcher::Event> Utils::FileWatcher::fetchEvents(std::chrono::milliseconds settleTime, bool &needsRescan)
+{
+  std::vector<Event> res{};
+  std::lock_guard lock{mtx};
+
+  needsRescan = false;
+  if(pending.empty() && !overflow)return res;
+  if(std::chrono::steady_clock::now() - lastEventTime < settleTime)return res;
+
+  needsRescan = overflow;
+  overflow = false;
+
+  std::vector<std::pair<uint32_t, Event>> sorted{};
+  sorted.reserve(pending.size());
+  for(auto &[path, ev] : pending) {
+    sorted.push_back({ev.order, {path, ev.type, ev.isDir}});
+  }
+  pending.clear();
+  eventOrder = 0;
+
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  res.reserve(sorted.size());
+  for(auto &[order, ev] : sorted) {
+    res.push_back(std::move(ev));
+  }
+  return res;
+}
@@ -0,0 +1,94 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Utils
+{
+  /**
+   * Event based watcher for a set of directory trees (recursive).
+   * Events are collected by a background thread and coalesced per path,
+   * so multiple writes to the same file only result in a single event.
+   *
+   * Currently only implemented via inotify on Linux.
+   * On other platforms (or if setting up the watch failed) 'isActive' returns false,
+   * and the caller has to fall back to scanning the directories itself.
+   */
+  class FileWatcher
+  {
+    public:
+      enum class EventType : uint8_t
+      {
+        CREATED,
+        MODIFIED,
+        DELETED,
+      };
+
+      struct Event
+      {
+        std::string path{};
+        EventType type{};
+        bool isDir{false}; // for deleted directories, all files inside are gone too
+      };
+
+    private:
+      struct PendingEvent
+      {
+        EventType type{};
+        bool isDir{false};
+        uint32_t order{};
+      };
+
+      int fd{-1};
+      std::unordered_map<int, std::string> watchDirs{};
+      std::unordered_map<std::string, PendingEvent> pending{};
+      std::chrono::steady_clock::time_point lastEventTime{};
+      uint32_t eventOrder{0};
+      bool overflow{false};
+
+      std::mutex mtx{};
+      std::thread thread{};
+      std::atomic_bool running{false};
+
+      void addWatchRecursive(const fs::path &dir, bool emitFiles);
+      void pushEvent(const std::string &path, EventType type, bool isDir);
+      void threadMain();
+
+    public:
+      FileWatcher() = default;
+      ~FileWatcher() { stop(); }
+
+      FileWatcher(const FileWatcher&) = delete;
+      FileWatcher& operator=(const FileWatcher&) = delete;
+
+      /**
+       * Starts watching the given directories, stopping any previous watch.
+       * @return true if the watch is active, false if polling must be used instead
+       */
+      bool start(const std::vector<fs::path> &dirs);
+      void stop();
+
+      [[nodiscard]] bool isActive() const { return running; }
+
+      /**
+       * Returns all pending events in the order they first occurred, and clears them.
+       * Nothing is returned until no new event arrived for 'settleTime',
+       * this avoids picking up files that are still being written.
+       *
+       * @param settleTime min. time since the last event
+       * @param needsRescan set to true if events got lost (kernel queue overflow)
+       */
+      std::vector<Event> fetchEvents(std::chrono::milliseconds settleTime, bool &needsRescan);
+  };
+}
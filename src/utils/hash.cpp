@@ -4,6 +4,7 @@
 */
 #include "hash.h"
 
+#include <mutex>
 #include <random>
 
 namespace
@@ -14,9 +15,11 @@ namespace
     std::numeric_limits<std::uint64_t>::min(),
     std::numeric_limits<std::uint64_t>::max()
   );
+  std::mutex mtx{}; // assets are loaded from multiple threads
 }
 
 uint64_t Utils::Hash::randomU64()
 {
+  std::lock_guard lock{mtx};
   return dis(e);
 }
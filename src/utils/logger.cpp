@@ -18,6 +18,10 @@ namespace
   constinit Utils::Logger::LogOutputFunc outputFunc = nullptr;
   constinit int minLevel = Utils::Logger::LEVEL_INFO;
 
+  // per-thread buffer for grouped output, see 'beginGroup'
+  thread_local bool isGrouped{false};
+  thread_local std::string groupBuff{};
+
   void trimBuffer()
   {
     if (buff.length() > MAX_BUFF_SIZE) {
@@ -77,6 +81,11 @@ void Utils::Logger::log(const std::string&msg, int level)
     return;
   }
 
+  if(isGrouped) {
+    groupBuff += '[' + nowStr() + "] [" + levelTag(level) + "] " + msg + "\n";
+    return;
+  }
+
   buff += '[' + nowStr() + "] [" + levelTag(level) + "] " + msg + "\n";
   trimBuffer();
 
@@ -92,6 +101,11 @@ void Utils::Logger::logRaw(const std::string&msg, int level) {
     return;
   }
 
+  if(isGrouped) {
+    groupBuff += msg;
+    return;
+  }
+
   buff += msg;
   trimBuffer();
 
@@ -110,3 +124,23 @@ std::string Utils::Logger::getLog() {
   std::lock_guard lock{mtx};
   return buff;
 }
+
+void Utils::Logger::beginGroup() {
+  isGrouped = true;
+  groupBuff.clear();
+}
+
+void Utils::Logger::endGroup() {
+  isGrouped = false;
+  if(groupBuff.empty())return;
+
+  std::lock_guard lock{mtx};
+  buff += groupBuff;
+  groupBuff.clear();
+  trimBuffer();
+
+  if (outputFunc) {
+    outputFunc(buff);
+    buff = "";
+  }
+}
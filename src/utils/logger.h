@@ -22,4 +22,11 @@ namespace Utils::Logger
   void logRaw(const std::string &msg, int level = LEVEL_INFO);
   void clear();
   std::string getLog();
+
+  /**
+   * Buffers all log output of the calling thread until 'endGroup' is called.
+   * Used to keep the output of jobs running in parallel together.
+   */
+  void beginGroup();
+  void endGroup();
 }
\ No newline at end of file
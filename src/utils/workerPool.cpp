@@ -0,0 +1,80 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include "workerPool.h"
+
+#include <algorithm>
+#include "logger.h"
+
+Utils::WorkerPool::WorkerPool(uint32_t threadCount)
+{
+  if(threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  threads.reserve(threadCount);
+  for(uint32_t i=0; i<threadCount; ++i) {
+    threads.emplace_back(&WorkerPool::threadMain, this);
+  }
+}
+
+Utils::WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard lock{mtx};
+    stopping = true;
+    tasks.clear();
+  }
+  cvTask.notify_all();
+  for(auto &t : threads)t.join();
+}
+
+void Utils::WorkerPool::push(std::function<void()> task)
+{
+  {
+    std::lock_guard lock{mtx};
+    tasks.push_back(std::move(task));
+  }
+  cvTask.notify_one();
+}
+
+void Utils::WorkerPool::wait()
+{
+  std::unique_lock lock{mtx};
+  cvIdle.wait(lock, [this] { return tasks.empty() && tasksRunning == 0; });
+}
+
+void Utils::WorkerPool::clear()
+{
+  {
+    std::lock_guard lock{mtx};
+    tasks.clear();
+  }
+  cvIdle.notify_all();
+}
+
+void Utils::WorkerPool::threadMain()
+{
+  std::unique_lock lock{mtx};
+  for(;;)
+  {
+    cvTask.wait(lock, [this] { return stopping || !tasks.empty(); });
+    if(stopping)return;
+
+    auto task = std::move(tasks.front());
+    tasks.pop_front();
+    ++tasksRunning;
+    lock.unlock();
+
+    try {
+      task();
+    } catch(const std::exception &e) {
+      Utils::Logger::log(std::string{"Background task failed: "} + e.what(), Utils::Logger::LEVEL_ERROR);
+    }
+
+    lock.lock();
+    --tasksRunning;
+    if(tasks.empty() && tasksRunning == 0)cvIdle.notify_all();
+  }
+}
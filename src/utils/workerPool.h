@@ -0,0 +1,56 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+  /**
+   * Fixed set of background threads working through a shared FIFO of tasks.
+   * Tasks must not touch state owned by the main thread,
+   * results are expected to be handed back through a separate (locked) queue.
+   */
+  class WorkerPool
+  {
+    private:
+      std::vector<std::thread> threads{};
+      std::deque<std::function<void()>> tasks{};
+      std::mutex mtx{};
+      std::condition_variable cvTask{};
+      std::condition_variable cvIdle{};
+      uint32_t tasksRunning{0};
+      bool stopping{false};
+
+      void threadMain();
+
+    public:
+      /**
+       * @param threadCount number of threads, 0 to use the number of CPU cores
+       */
+      explicit WorkerPool(uint32_t threadCount = 0);
+      ~WorkerPool();
+
+      WorkerPool(const WorkerPool&) = delete;
+      WorkerPool& operator=(const WorkerPool&) = delete;
+
+      void push(std::function<void()> task);
+
+      /**
+       * Blocks until all queued tasks are done.
+       */
+      void wait();
+
+      /**
+       * Drops all tasks that have not started yet.
+       */
+      void clear();
+  };
+}
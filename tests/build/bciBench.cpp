@@ -0,0 +1,141 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "lodepng.h"
+#include "../../src/build/tools/bci.h"
+#include "bciReference.h"
+
+/**
+ * Encodes images with each BCI preset, and reports throughput and quality.
+ * The encoder before the presets ('bciReference.h') is listed first for comparison.
+ * Usage: benchBCI [image.png ...], uses generated test images if none are given.
+ */
+namespace
+{
+  struct Image
+  {
+    std::string name{};
+    std::vector<uint8_t> rgba{};
+    uint32_t width{};
+    uint32_t height{};
+  };
+
+  constexpr const char* QUALITY_NAMES[3] = {"FAST", "BALANCED", "BEST"};
+
+  // mix of smooth gradients, hard edges and noise, similar to typical textures
+  Image generateImage(uint32_t size)
+  {
+    Image img{"generated " + std::to_string(size) + "x" + std::to_string(size), {}, size, size};
+    img.rgba.resize(size * size * 4);
+    uint32_t rng = 1234;
+    for(uint32_t y=0; y<size; ++y) {
+      for(uint32_t x=0; x<size; ++x) {
+        rng = rng * 1664525 + 1013904223;
+        uint8_t noise = (rng >> 24) & 0x1F;
+        bool checker = ((x / 16) + (y / 16)) & 1;
+        auto px = &img.rgba[(y * size + x) * 4];
+        px[0] = (x * 255 / size) ^ (checker ? 0x40 : 0);
+        px[1] = (y * 255 / size) + noise;
+        px[2] = checker ? 200 : (uint8_t)(128 + 100 * sinf(x * 0.1f));
+        px[3] = 0xFF;
+      }
+    }
+    return img;
+  }
+
+  // decodes the BCI blocks again and compares them with the source, alpha is ignored
+  double calcPSNR(const Image &img, const std::vector<uint8_t> &bci)
+  {
+    uint32_t blocksX = (img.width + 3) / 4;
+    double errSum = 0.0;
+    for(uint32_t y=0; y<img.height; ++y) {
+      for(uint32_t x=0; x<img.width; ++x) {
+        const uint8_t *block = &bci[((y / 4) * blocksX + (x / 4)) * 16];
+        uint64_t indices = 0;
+        for(int i=0; i<8; ++i)indices = (indices << 8) | block[8 + i];
+        indices >>= 33;
+
+        uint32_t idx = (indices >> (((y % 4) * 4 + (x % 4)) * 2)) & 0b11;
+        uint16_t col = (block[idx*2] << 8) | block[idx*2 + 1];
+        int dec[3] = {(col >> 11) & 0x1F, (col >> 6) & 0x1F, (col >> 1) & 0x1F};
+
+        auto px = &img.rgba[(y * img.width + x) * 4];
+        for(int c=0; c<3; ++c) {
+          double diff = (double)((dec[c] << 3) | (dec[c] >> 2)) - px[c];
+          errSum += diff * diff;
+        }
+      }
+    }
+    double mse = errSum / (img.width * img.height * 3);
+    return mse == 0.0 ? INFINITY : 10.0 * log10(255.0 * 255.0 / mse);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<Image> images{};
+  for(int i=1; i<argc; ++i) {
+    Image img{argv[i]};
+    std::vector<unsigned char> data;
+    unsigned w, h;
+    if(lodepng::decode(data, w, h, argv[i])) {
+      printf("Failed to load %s\n", argv[i]);
+      return 1;
+    }
+    img.rgba.assign(data.begin(), data.end());
+    img.width = w;
+    img.height = h;
+    images.push_back(std::move(img));
+  }
+  if(images.empty()) {
+    images.push_back(generateImage(256));
+    images.push_back(generateImage(1024));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  bool allMatch = true;
+
+  printf("%-24s %-9s %14s %14s %8s\n", "Image", "Preset", "Blocks/s (1T)", "Blocks/s (MT)", "PSNR");
+  for(auto &img : images)
+  {
+    double blockCount = ((img.width + 3) / 4) * ((img.height + 3) / 4);
+
+    // single-threaded only
+    auto tRefStart = Clock::now();
+    auto resRef = Test::BCIReference::encode(img.rgba, img.width, img.height);
+    double secRef = std::chrono::duration<double>(Clock::now() - tRefStart).count();
+    printf("%-24s %-9s %14.0f %14s %8.2f\n", img.name.c_str(), "REFERENCE",
+      blockCount / secRef, "-", calcPSNR(img, resRef));
+
+    for(int q=0; q<3; ++q)
+    {
+      auto quality = (Build::BCI::Quality)q;
+
+      auto t0 = Clock::now();
+      auto resSingle = Build::BCI::encode(img.rgba, img.width, img.height, quality, 1);
+      auto t1 = Clock::now();
+      auto resMulti = Build::BCI::encode(img.rgba, img.width, img.height, quality, 0);
+      auto t2 = Clock::now();
+
+      // the output must not depend on the number of threads
+      allMatch &= resSingle == resMulti;
+
+      double secSingle = std::chrono::duration<double>(t1 - t0).count();
+      double secMulti = std::chrono::duration<double>(t2 - t1).count();
+      printf("%-24s %-9s %14.0f %14.0f %8.2f\n", img.name.c_str(), QUALITY_NAMES[q],
+        blockCount / secSingle, blockCount / secMulti, calcPSNR(img, resSingle));
+    }
+  }
+
+  if(!allMatch) {
+    printf("Error: single- and multi-threaded results differ\n");
+    return 1;
+  }
+  return 0;
+}
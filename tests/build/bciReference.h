@@ -0,0 +1,161 @@
+/**
+* @copyright 2025 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+/**
+ * The BCI encoder before the presets were added (random k-means, 100 iterations, double distances),
+ * kept as a reference for 'benchBCI'. Same block layout as 'Build::BCI::encode'.
+ */
+namespace Test::BCIReference
+{
+  struct Color {
+    int r, g, b;
+    Color operator+(const Color& other) const {
+      return {r + other.r, g + other.g, b + other.b};
+    }
+    Color operator/(int val) const {
+      return {r / val, g / val, b / val};
+    }
+    double distance(const Color& other) const {
+      return sqrt(pow(r - other.r, 2) + pow(g - other.g, 2) + pow(b - other.b, 2));
+    }
+    bool operator==(const Color&other) const {
+      return r == other.r && g == other.g && b == other.b;
+    }
+    uint16_t toRGBA555() const {
+      return ((r << 8) & 0b11111'00000'00000'0)
+       |     ((g << 3) & 0b00000'11111'00000'0)
+       |     ((b >> 2) & 0b00000'00000'11111'0);
+    }
+  };
+
+  using Block = std::array<Color, 16>;  // 4x4 block of pixels
+  using Palette = std::array<Color, 4>; // 4-color palette
+  using Indices = std::array<int, 16>;  // Indices for each pixel in the block
+
+  // Initialize K-means with random colors from the block
+  inline void initialize_palette(const Block& block, Palette& palette) {
+    for (int i = 0; i < 4; ++i) {
+      palette[i] = block[rand() % 16];
+    }
+  }
+
+  // Assign each pixel to the nearest palette color
+  inline Indices assign_clusters(const Block& block, const Palette& palette) {
+    Indices assignments;
+    for (int i = 0; i < 16; ++i) {
+      double min_dist = std::numeric_limits<double>::max();
+      int best_cluster = 0;
+      for (int j = 0; j < 4; ++j) {
+        double dist = block[i].distance(palette[j]);
+        if (dist < min_dist) {
+          min_dist = dist;
+          best_cluster = j;
+        }
+      }
+      assignments[i] = best_cluster;
+    }
+    return assignments;
+  }
+
+  // Update palette colors based on assignments
+  inline void update_palette(const Block& block, Palette& palette, const Indices& assignments) {
+    std::array<Color, 4> new_colors = {};
+    std::array<int, 4> counts = {};
+
+    for (int i = 0; i < 16; ++i) {
+      int cluster = assignments[i];
+      new_colors[cluster] = new_colors[cluster] + block[i];
+      counts[cluster]++;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+      if (counts[i] > 0) {
+        palette[i] = new_colors[i] / counts[i];
+      }
+    }
+  }
+
+  // K-means clustering to generate a 4-color palette and indices
+  inline std::pair<Palette, Indices> kmeansPalette(const Block& block, int max_iters = 100) {
+    Palette palette;
+    initialize_palette(block, palette);
+    Indices assignments;
+
+    for (int iter = 0; iter < max_iters; ++iter) {
+      assignments = assign_clusters(block, palette);
+      Palette new_palette = palette;
+      update_palette(block, new_palette, assignments);
+
+      if (palette == new_palette) break; // Converged
+      palette = new_palette;
+    }
+
+    return {palette, assignments};
+  }
+
+  // same as the old 'convertPNG', writing into memory instead of a file
+  inline std::vector<uint8_t> encode(const std::vector<uint8_t> &image, uint32_t width, uint32_t height)
+  {
+    std::vector<uint8_t> res{};
+    auto writeU16 = [&res](uint16_t val) {
+      res.push_back(val >> 8);
+      res.push_back(val & 0xFF);
+    };
+    auto writeU64 = [&res](uint64_t val) {
+      for(int i=7; i>=0; --i)res.push_back((val >> (i*8)) & 0xFF);
+    };
+
+    srand(1); // the old encoder never seeded, keep runs comparable
+    for (unsigned y = 0; y < height; y += 4) {
+      for (unsigned x = 0; x < width; x += 4) {
+        Block block{};
+        for (int i = 0; i < 16; ++i) {
+          unsigned px = x + (i % 4);
+          unsigned py = y + (i / 4);
+          if (px >= width || py >= height) continue;
+          unsigned index = 4 * (py * width + px);
+          block[i] = {image[index], image[index + 1], image[index + 2]};
+        }
+
+        auto [palette, indices] = kmeansPalette(block);
+
+        // Note: the first index must be 0b00 or 0b01 due to runtime opt.
+        // If that is not the case, swap the colors and indices
+        if(indices[15] != 0) {
+          auto replA = indices[15];
+
+          auto tmp = palette[replA];
+          palette[replA] = palette[0];
+          palette[0] = tmp;
+
+          for(uint32_t i=0; i<16; ++i) {
+            if(indices[i] == replA)indices[i] = 0;
+            else if(indices[i] == 0)indices[i] = replA;
+          }
+        }
+
+        writeU16(palette[0].toRGBA555());
+        writeU16(palette[1].toRGBA555());
+        writeU16(palette[2].toRGBA555());
+        writeU16(palette[3].toRGBA555());
+
+        uint64_t packedIndex = 0;
+        for(int i=0; i<16; ++i) {
+          packedIndex <<= 2;
+          packedIndex |= indices[15-i];
+        }
+        writeU64(packedIndex << 33);
+      }
+    }
+    return res;
+  }
+}
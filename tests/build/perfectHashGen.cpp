@@ -0,0 +1,61 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../../src/build/perfectHash.h"
+#include "../../src/utils/fs.h"
+#include "../../src/utils/string.h"
+
+/**
+ * Generates an asset table header the same way the project build does, for 'perfectHashTest.cpp'.
+ * Keys are the asset paths of all given projects, each key's value is its index in 'ASSET_INPUT_KEYS',
+ * which is appended to the header so the test knows what to look up.
+ * Usage: perfectHashGen <template> <out-header> <project-dir ...>
+ */
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv)
+{
+  if(argc < 3) {
+    printf("Usage: perfectHashGen <template> <out-header> <project-dir ...>\n");
+    return 1;
+  }
+
+  // same naming as the asset table, paths relative to the asset directory
+  std::vector<std::string> keys{};
+  for(int i=3; i<argc; ++i) {
+    auto assetDir = fs::path{argv[i]} / "assets";
+    for(auto &entry : fs::recursive_directory_iterator{assetDir}) {
+      if(!entry.is_regular_file() || entry.path().extension() == ".conf")continue;
+      keys.push_back(fs::relative(entry.path(), assetDir).generic_string());
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<uint32_t> values(keys.size());
+  Build::PerfectHash::removeDuplicates(keys, values);
+  std::string inputKeys{};
+  for(uint32_t i=0; i<keys.size(); ++i) {
+    values[i] = i;
+    inputKeys += "\"" + keys[i] + "\",";
+  }
+
+  auto tmpl = Utils::FS::loadTextFile(argv[1]);
+  if(tmpl.empty()) {
+    printf("Failed to load template %s\n", argv[1]);
+    return 1;
+  }
+
+  auto code = Utils::replaceAll(tmpl, "{{ASSET_MAP}}", Build::PerfectHash::toCode("ASSET", keys, values));
+  code += "\nnamespace Test\n{\n"
+    "  constexpr std::array<std::string_view, " + std::to_string(keys.size()) + "> ASSET_INPUT_KEYS{" + inputKeys + "};\n"
+    "}\n";
+
+  Utils::FS::saveTextFile(argv[2], code);
+  return 0;
+}
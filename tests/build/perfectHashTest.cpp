@@ -0,0 +1,152 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../src/build/perfectHash.h"
+#include "../../n64/engine/include/lib/perfectHash.h"
+#include "assetTable.h" // generated by 'perfectHashGen' from the project's template
+
+/**
+ * Creates tables for real and random key sets, and checks that every key resolves to itself,
+ * while keys not in the table are rejected.
+ * The same is checked for the code the build emits, by including a generated asset table.
+ * Usage: testPerfectHash [project-dir ...], asset paths of each project are used as a key set.
+ */
+namespace fs = std::filesystem;
+
+namespace
+{
+  bool checkKeys(const std::string &name, const std::vector<std::string> &keys)
+  {
+    auto table = Build::PerfectHash::create(keys);
+    uint32_t count = keys.size();
+    if(table.seeds.size() != count || table.slots.size() != count) {
+      printf("[%s] table has the wrong size\n", name.c_str());
+      return false;
+    }
+
+    // same layout as the generated code, keys sorted by slot
+    std::vector<std::string_view> slotKeys(count);
+    for(uint32_t i=0; i<count; ++i) {
+      if(table.slots[i] >= count) {
+        printf("[%s] slot %u is empty\n", name.c_str(), i);
+        return false;
+      }
+      slotKeys[i] = keys[table.slots[i]];
+    }
+
+    for(uint32_t i=0; i<count; ++i) {
+      auto slot = P64::PerfectHash::find(keys[i], table.seeds.data(), slotKeys.data(), count);
+      if(slot == P64::PerfectHash::NOT_FOUND || table.slots[slot] != i) {
+        printf("[%s] key '%s' not found\n", name.c_str(), keys[i].c_str());
+        return false;
+      }
+
+      auto unknownKey = keys[i] + "#";
+      if(P64::PerfectHash::find(unknownKey, table.seeds.data(), slotKeys.data(), count) != P64::PerfectHash::NOT_FOUND) {
+        printf("[%s] unknown key '%s' was found\n", name.c_str(), unknownKey.c_str());
+        return false;
+      }
+    }
+
+    printf("[%s] %u keys OK\n", name.c_str(), count);
+    return true;
+  }
+
+  std::vector<std::string> randomKeys(uint32_t count, uint32_t seed)
+  {
+    std::mt19937 rng{seed};
+    std::vector<std::string> keys{};
+    std::vector<uint32_t> values{};
+    while(keys.size() < count) {
+      // short keys with a small alphabet, to get many similar ones
+      std::string key = "p64/";
+      uint32_t len = 1 + rng() % 12;
+      for(uint32_t i=0; i<len; ++i)key += (char)('a' + rng() % 6);
+      keys.push_back(key);
+      values.push_back(0);
+      if(keys.size() == count)Build::PerfectHash::removeDuplicates(keys, values);
+    }
+    return keys;
+  }
+
+  // same lookup as the '_asset' literal, evaluated at compile time
+  consteval bool generatedKeysResolve()
+  {
+    for(uint32_t i=0; i<Test::ASSET_INPUT_KEYS.size(); ++i) {
+      if(P64::Assets::getAssetIndex(Test::ASSET_INPUT_KEYS[i]) != i)return false;
+    }
+    return true;
+  }
+  static_assert(generatedKeysResolve());
+
+  bool checkGenerated()
+  {
+    using namespace P64::Assets;
+    auto &keys = Test::ASSET_INPUT_KEYS;
+    bool ok = !keys.empty();
+
+    for(uint32_t i=0; i<keys.size(); ++i) {
+      auto slot = P64::PerfectHash::find(keys[i], Table::ASSET_SEEDS, Table::ASSET_KEYS);
+      if(slot == P64::PerfectHash::NOT_FOUND || Table::ASSET_VALUES[slot] != i) {
+        printf("[generated] key '%s' not found\n", std::string{keys[i]}.c_str());
+        ok = false;
+      }
+
+      // lands in a used slot most of the time, so only the final string compare can reject it
+      auto unknownKey = std::string{keys[i]} + "#";
+      if(P64::PerfectHash::find(unknownKey, Table::ASSET_SEEDS, Table::ASSET_KEYS) != P64::PerfectHash::NOT_FOUND) {
+        printf("[generated] unknown key '%s' was found\n", unknownKey.c_str());
+        ok = false;
+      }
+    }
+
+    printf("[generated] %u keys %s\n", (uint32_t)keys.size(), ok ? "OK" : "FAILED");
+    return ok;
+  }
+
+  bool checkDuplicates()
+  {
+    std::vector<std::string> keys{"a", "b", "a", "c", "b", "a"};
+    std::vector<uint32_t> values{0, 1, 2, 3, 4, 5};
+    auto removed = Build::PerfectHash::removeDuplicates(keys, values);
+
+    bool ok = keys == std::vector<std::string>{"a", "b", "c"}
+      && values == std::vector<uint32_t>{0, 1, 3}
+      && removed == std::vector<std::string>{"a", "b", "a"};
+
+    printf("[duplicates] %s\n", ok ? "OK" : "FAILED");
+    return ok;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool ok = checkDuplicates();
+  ok &= checkGenerated();
+
+  for(int i=1; i<argc; ++i)
+  {
+    // same naming as the asset table, paths relative to the asset directory
+    auto assetDir = fs::path{argv[i]} / "assets";
+    std::vector<std::string> keys{};
+    for(auto &entry : fs::recursive_directory_iterator{assetDir}) {
+      if(!entry.is_regular_file() || entry.path().extension() == ".conf")continue;
+      keys.push_back(fs::relative(entry.path(), assetDir).generic_string());
+    }
+    ok &= checkKeys(fs::path{argv[i]}.filename().string(), keys);
+  }
+
+  for(uint32_t count : {0u, 1u, 2u, 3u, 7u, 64u, 100u, 1000u, 20000u}) {
+    for(uint32_t seed=1; seed<=3; ++seed) {
+      ok &= checkKeys("random " + std::to_string(count) + "/" + std::to_string(seed), randomKeys(count, seed));
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "lib/arena.h"
+
+/**
+ * Allocates and frees random blocks (incl. ones too large for a size class) over many rounds.
+ * Each block is filled with its own pattern, which must survive until it gets freed.
+ * Also checks alignment, free-list re-use, that large blocks go back to the heap, and the stats after 'reset'.
+ */
+using P64::Mem::Arena;
+
+namespace
+{
+  struct Block {
+    uint8_t *ptr;
+    uint32_t size;
+    uint8_t pattern;
+  };
+
+  bool check(const char* name, bool ok)
+  {
+    if(!ok)printf("[%s] FAILED\n", name);
+    return ok;
+  }
+
+  bool checkPattern(const Block &block) {
+    for(uint32_t i=0; i<block.size; ++i) {
+      if(block.ptr[i] != block.pattern)return false;
+    }
+    return true;
+  }
+
+  // headers are part of the block, so the next one must start after it
+  bool checkNoOverlap(std::vector<Block> blocks) {
+    std::sort(blocks.begin(), blocks.end(), [](const Block &a, const Block &b) { return a.ptr < b.ptr; });
+    for(uint32_t i=1; i<blocks.size(); ++i) {
+      if(blocks[i-1].ptr + blocks[i-1].size > blocks[i].ptr - Arena::HEADER_SIZE)return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<uint32_t> smallSize{1, 600};
+  std::uniform_int_distribution<uint32_t> largeSize{4096, 12000};
+
+  Arena arena{};
+  std::vector<Block> blocks{};
+  uint8_t nextPattern = 1;
+  bool ok = true;
+
+  auto alloc = [&](uint32_t size) {
+    Block block{(uint8_t*)arena.alloc(size), size, nextPattern++};
+    if(nextPattern == 0)nextPattern = 1;
+    memset(block.ptr, block.pattern, size);
+    blocks.push_back(block);
+    return block;
+  };
+
+  for(uint32_t round=0; round<200 && ok; ++round)
+  {
+    for(uint32_t i=0; i<40; ++i) {
+      auto block = alloc(rng() % 16 == 0 ? largeSize(rng) : smallSize(rng));
+      ok &= check("8-byte aligned", ((uintptr_t)block.ptr % 8) == 0);
+    }
+
+    // free about half, in random order
+    std::shuffle(blocks.begin(), blocks.end(), rng);
+    uint32_t freeCount = blocks.size() / 2;
+    for(uint32_t i=0; i<freeCount; ++i) {
+      auto &block = blocks.back();
+      ok &= check("pattern intact before free", checkPattern(block));
+      arena.free(block.ptr);
+      blocks.pop_back();
+    }
+
+    for(auto &block : blocks)ok &= check("pattern intact", checkPattern(block));
+    ok &= check("no overlap", checkNoOverlap(blocks));
+    ok &= check("alloc count", arena.getStats().allocCount == blocks.size());
+  }
+
+  // the last freed block of a class is handed out first
+  {
+    auto block = alloc(100);
+    auto hits = arena.getStats().freeListHits;
+    arena.free(block.ptr);
+    blocks.pop_back();
+    auto again = alloc(90);
+    ok &= check("free-list re-use", again.ptr == block.ptr && arena.getStats().freeListHits == hits + 1);
+  }
+
+  // large blocks are returned to the heap right away, chunks stay
+  {
+    auto stats = arena.getStats();
+    auto block = alloc(20000);
+    auto statsLarge = arena.getStats();
+    ok &= check("large block reserved", statsLarge.bytesReserved > stats.bytesReserved
+      && statsLarge.chunkCount == stats.chunkCount);
+
+    arena.free(block.ptr);
+    blocks.pop_back();
+    auto statsFreed = arena.getStats();
+    ok &= check("large block freed", statsFreed.bytesReserved == stats.bytesReserved
+      && statsFreed.bytesUsed == stats.bytesUsed && statsFreed.allocCount == stats.allocCount);
+  }
+
+  // a size that fills a class incl. the header must not be rounded up to the next one
+  for(auto classSize : Arena::CLASS_SIZES) {
+    auto used = arena.getStats().bytesUsed;
+    alloc(classSize - Arena::HEADER_SIZE);
+    ok &= check("exact size class", arena.getStats().bytesUsed == used + classSize);
+  }
+
+  for(auto &block : blocks)ok &= check("pattern intact at the end", checkPattern(block));
+
+  arena.reset();
+  auto &stats = arena.getStats();
+  ok &= check("stats reset", stats.chunkCount == 0 && stats.bytesReserved == 0 && stats.bytesUsed == 0
+    && stats.bytesUsedPeak == 0 && stats.allocCount == 0 && stats.freeListHits == 0);
+
+  // still usable after a reset
+  auto ptr = arena.alloc(64);
+  ok &= check("alloc after reset", ptr && arena.getStats().allocCount == 1 && arena.getStats().chunkCount == 1);
+
+  if(ok)printf("OK\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "collision/broadphase.h"
+
+/**
+ * Compares the sweep-and-prune broadphase with checking all pairs (as done before),
+ * for a scene of moving colliders spread over a level.
+ */
+using P64::Coll::Broadphase;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr uint32_t FRAMES = 200;
+
+  uint32_t bruteForce(const std::vector<Broadphase::Bounds> &bounds) {
+    uint32_t count = 0;
+    for(uint32_t a=0; a<bounds.size(); ++a) {
+      for(uint32_t b=a+1; b<bounds.size(); ++b) {
+        bool overlap = true;
+        for(int i=0; i<3; ++i) {
+          if(bounds[a].max[i] < bounds[b].min[i] || bounds[b].max[i] < bounds[a].min[i])overlap = false;
+        }
+        count += overlap;
+      }
+    }
+    return count;
+  }
+}
+
+int main()
+{
+  printf("%8s %16s %16s %10s\n", "Bodies", "SAP (us/frame)", "All (us/frame)", "Pairs");
+
+  for(uint32_t count : {16u, 32u, 64u, 128u, 256u, 512u, 1024u})
+  {
+    std::mt19937 rng{count};
+    std::uniform_real_distribution<float> pos{-200.0f, 200.0f};
+    std::uniform_real_distribution<float> step{-0.5f, 0.5f};
+
+    std::vector<Broadphase::Bounds> bounds(count);
+    for(auto &b : bounds) {
+      for(int i=0; i<3; ++i) {
+        b.min[i] = pos(rng) * (i == 1 ? 0.1f : 1.0f);
+        b.max[i] = b.min[i] + 4.0f;
+      }
+    }
+
+    Broadphase broadphase{};
+    for(uint32_t i=0; i<count; ++i) {
+      broadphase.add();
+      broadphase.setBounds(i, bounds[i]);
+    }
+
+    double timeSAP = 0.0;
+    double timeAll = 0.0;
+    uint32_t pairsSAP = 0;
+    uint32_t pairsAll = 0;
+
+    for(uint32_t f=0; f<FRAMES; ++f)
+    {
+      for(uint32_t i=0; i<count; ++i) {
+        float d = step(rng);
+        bounds[i].min[0] += d;
+        bounds[i].max[0] += d;
+        broadphase.setBounds(i, bounds[i]);
+      }
+
+      auto t0 = Clock::now();
+      pairsSAP += broadphase.update().size();
+      auto t1 = Clock::now();
+      pairsAll += bruteForce(bounds);
+      auto t2 = Clock::now();
+
+      timeSAP += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      timeAll += std::chrono::duration<double, std::micro>(t2 - t1).count();
+    }
+
+    if(pairsSAP != pairsAll) {
+      printf("Error: pair count mismatch (%u vs %u)\n", pairsSAP, pairsAll);
+      return 1;
+    }
+    printf("%8u %16.2f %16.2f %10.1f\n", count, timeSAP / FRAMES, timeAll / FRAMES, (double)pairsSAP / FRAMES);
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "collision/broadphase.h"
+
+/**
+ * Moves, adds and removes random proxies over many frames, and compares the pairs
+ * and query results of the broadphase with a brute-force check of all proxies.
+ */
+using P64::Coll::Broadphase;
+
+namespace
+{
+  struct Pair {
+    uint16_t a, b;
+    bool operator==(const Pair&) const = default;
+  };
+
+  bool overlaps(const Broadphase::Bounds &a, const Broadphase::Bounds &b) {
+    for(int i=0; i<3; ++i) {
+      if(a.max[i] < b.min[i] || b.max[i] < a.min[i])return false;
+    }
+    return true;
+  }
+
+  std::vector<Pair> bruteForcePairs(const std::vector<Broadphase::Bounds> &bounds) {
+    std::vector<Pair> res{};
+    for(uint32_t a=0; a<bounds.size(); ++a) {
+      for(uint32_t b=a+1; b<bounds.size(); ++b) {
+        if(overlaps(bounds[a], bounds[b]))res.push_back({(uint16_t)a, (uint16_t)b});
+      }
+    }
+    return res;
+  }
+}
+
+int main()
+{
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> pos{-30.0f, 30.0f};
+  std::uniform_real_distribution<float> size{1.0f, 15.0f};
+  std::uniform_real_distribution<float> step{-1.5f, 1.5f};
+
+  auto randomBounds = [&]() {
+    Broadphase::Bounds b{};
+    for(int i=0; i<3; ++i) {
+      b.min[i] = pos(rng);
+      b.max[i] = b.min[i] + size(rng);
+    }
+    return b;
+  };
+
+  Broadphase broadphase{};
+  std::vector<Broadphase::Bounds> bounds{};
+  uint32_t pairCount = 0;
+  uint32_t queryCount = 0;
+
+  for(uint32_t frame=0; frame<500; ++frame)
+  {
+    // objects getting spawned and deleted
+    uint32_t changes = rng() % 4;
+    for(uint32_t c=0; c<changes; ++c) {
+      if(bounds.size() > 20 && (rng() % 2)) {
+        uint32_t idx = rng() % bounds.size();
+        bounds.erase(bounds.begin() + idx);
+        broadphase.remove(idx);
+      } else if(bounds.size() < 300) {
+        uint32_t idx = broadphase.add();
+        if(idx != bounds.size()) {
+          printf("Frame %u: add() returned %u, expected %zu\n", frame, idx, bounds.size());
+          return 1;
+        }
+        bounds.push_back(randomBounds());
+        broadphase.setBounds(idx, bounds.back());
+      }
+    }
+
+    for(uint32_t i=0; i<bounds.size(); ++i) {
+      auto &b = bounds[i];
+      for(int a=0; a<3; ++a) {
+        float d = step(rng);
+        b.min[a] += d;
+        b.max[a] += d;
+      }
+      broadphase.setBounds(i, b);
+    }
+
+    // queries before 'update' must see the new bounds too
+    auto area = randomBounds();
+    area.max[0] += 20.0f;
+    std::vector<uint32_t> hits{};
+    broadphase.query(area, [&](uint32_t idx) { hits.push_back(idx); });
+    std::sort(hits.begin(), hits.end());
+
+    std::vector<uint32_t> expectedHits{};
+    for(uint32_t i=0; i<bounds.size(); ++i) {
+      if(overlaps(area, bounds[i]))expectedHits.push_back(i);
+    }
+    if(hits != expectedHits) {
+      printf("Frame %u: query returned %zu proxies, expected %zu\n", frame, hits.size(), expectedHits.size());
+      return 1;
+    }
+    queryCount += hits.size();
+
+    std::vector<Pair> pairs{};
+    for(auto &p : broadphase.update())pairs.push_back({p.a, p.b});
+    auto expected = bruteForcePairs(bounds);
+    if(pairs != expected) {
+      printf("Frame %u: %zu pairs, expected %zu\n", frame, pairs.size(), expected.size());
+      return 1;
+    }
+    pairCount += pairs.size();
+  }
+
+  printf("OK, %u pairs and %u query results checked\n", pairCount, queryCount);
+  return 0;
+}
@@ -0,0 +1,268 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+#include "collMesh.h"
+
+/**
+ * Builds BVHs like the editor does and checks them as the runtime reads them:
+ * - every input triangle is in the mesh once, with its own vertices and normal
+ * - every node decoded from its parent still covers its triangles, and isn't much bigger than them
+ * - every triangle is in exactly one leaf-node
+ * - AABB and ray queries find the same triangles / hits as testing all triangles
+ */
+namespace
+{
+  P64::Scene gameScene{};
+
+  using P64::Coll::AABB;
+
+  struct TreeStats
+  {
+    uint32_t nodes{};
+    uint32_t depth{};
+    int maxSlack{}; // max. distance between a leaf's bounds and its triangles
+  };
+
+  AABB getTriangleBounds(const Test::CollMesh &mesh, uint32_t t)
+  {
+    auto tri = mesh.getTriangle(t);
+    AABB res{{INT16_MAX, INT16_MAX, INT16_MAX}, {INT16_MIN, INT16_MIN, INT16_MIN}};
+    for(auto &v : tri.v) {
+      for(int i=0; i<3; ++i) {
+        res.min.v[i] = std::min(res.min.v[i], (int16_t)floorf(v.v[i]));
+        res.max.v[i] = std::max(res.max.v[i], (int16_t)ceilf(v.v[i]));
+      }
+    }
+    return res;
+  }
+
+  bool checkTriangles(const std::string &name, const Test::CollMesh &mesh)
+  {
+    // quantized vertices of a triangle, in order
+    using TriVerts = std::array<int16_t, 9>;
+    auto triCount = mesh.mesh->triCount;
+    if(triCount != mesh.indicesInput.size() / 3) {
+      printf("[%s] mesh has %u of %u triangles\n", name.c_str(), triCount, (uint32_t)mesh.indicesInput.size() / 3);
+      return false;
+    }
+
+    std::vector<TriVerts> trisInput(triCount);
+    std::vector<TriVerts> trisMesh(triCount);
+    for(uint32_t t=0; t<triCount; ++t) {
+      for(int i=0; i<3; ++i) {
+        auto &vIn = mesh.vertsInput[mesh.indicesInput[t*3 + i]];
+        auto &vMesh = mesh.mesh->verts[mesh.mesh->indices[t*3 + i]];
+        for(int c=0; c<3; ++c) {
+          trisInput[t][i*3 + c] = (int16_t)roundf(vIn.v[c] / mesh.mesh->collScale);
+          trisMesh[t][i*3 + c] = vMesh.v[c];
+        }
+      }
+
+      // normal must still belong to the triangle after sorting
+      auto tri = mesh.getTriangle(t);
+      auto edge1 = tri.v[1] - tri.v[0];
+      auto edge2 = tri.v[2] - tri.v[0];
+      fm_vec3_t normal;
+      fm_vec3_cross(&normal, &edge1, &edge2);
+      fm_vec3_norm(&normal, &normal);
+      if(fm_vec3_dot(&normal, &tri.normal) < 0.99f) {
+        printf("[%s] triangle %u has the normal of another one\n", name.c_str(), t);
+        return false;
+      }
+    }
+
+    std::sort(trisInput.begin(), trisInput.end());
+    std::sort(trisMesh.begin(), trisMesh.end());
+    if(trisInput != trisMesh) {
+      printf("[%s] triangles differ from the input\n", name.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool checkNode(const Test::CollMesh &mesh, uint32_t nodeIdx, const AABB &parent, uint32_t depth,
+    std::vector<uint32_t> &triRefs, TreeStats &stats)
+  {
+    auto &bvh = *mesh.mesh->bvh;
+    if(nodeIdx >= bvh.nodeCount)return false;
+    auto &node = bvh.nodes[nodeIdx];
+    auto aabb = node.decode(parent);
+
+    ++stats.nodes;
+    stats.depth = std::max(stats.depth, depth);
+
+    // decoding can only shrink the parent
+    for(int i=0; i<3; ++i) {
+      if(aabb.min.v[i] < parent.min.v[i] || aabb.max.v[i] > parent.max.v[i])return false;
+    }
+
+    if(node.triCount == 0) {
+      return checkNode(mesh, node.index, aabb, depth + 1, triRefs, stats)
+        && checkNode(mesh, node.index + 1, aabb, depth + 1, triRefs, stats);
+    }
+
+    AABB triBounds{{INT16_MAX, INT16_MAX, INT16_MAX}, {INT16_MIN, INT16_MIN, INT16_MIN}};
+    for(uint32_t t = node.index; t < node.index + node.triCount; ++t) {
+      if(t >= triRefs.size())return false;
+      ++triRefs[t];
+      auto bounds = getTriangleBounds(mesh, t);
+      for(int i=0; i<3; ++i) {
+        triBounds.min.v[i] = std::min(triBounds.min.v[i], bounds.min.v[i]);
+        triBounds.max.v[i] = std::max(triBounds.max.v[i], bounds.max.v[i]);
+      }
+    }
+
+    for(int i=0; i<3; ++i) {
+      if(aabb.min.v[i] > triBounds.min.v[i] || aabb.max.v[i] < triBounds.max.v[i])return false;
+      stats.maxSlack = std::max(stats.maxSlack, triBounds.min.v[i] - aabb.min.v[i]);
+      stats.maxSlack = std::max(stats.maxSlack, aabb.max.v[i] - triBounds.max.v[i]);
+    }
+    return true;
+  }
+
+  bool checkTree(const std::string &name, const Test::CollMesh &mesh)
+  {
+    auto &bvh = *mesh.mesh->bvh;
+    std::vector<uint32_t> triRefs(mesh.mesh->triCount);
+    TreeStats stats{};
+
+    if(!checkNode(mesh, 0, bvh.bounds, 1, triRefs, stats)) {
+      printf("[%s] node bounds don't cover their triangles\n", name.c_str());
+      return false;
+    }
+    for(uint32_t t=0; t<triRefs.size(); ++t) {
+      if(triRefs[t] != 1) {
+        printf("[%s] triangle %u is in %u leaf-nodes\n", name.c_str(), t, triRefs[t]);
+        return false;
+      }
+    }
+    if(stats.nodes != bvh.nodeCount) {
+      printf("[%s] %u of %u nodes reachable\n", name.c_str(), stats.nodes, bvh.nodeCount);
+      return false;
+    }
+
+    // padding by the builder (incl. min. size) plus rounding of the 8-bit encoding
+    int rootSize = 0;
+    for(int i=0; i<3; ++i)rootSize = std::max(rootSize, bvh.bounds.max.v[i] - bvh.bounds.min.v[i]);
+    if(stats.maxSlack > 6 + (rootSize >> 8) + 1) {
+      printf("[%s] leaf-nodes are %d units bigger than their triangles\n", name.c_str(), stats.maxSlack);
+      return false;
+    }
+
+    printf("[%s] tree OK: %u tris, %u nodes, depth %u, max. slack %d\n", name.c_str(),
+      mesh.mesh->triCount, stats.nodes, stats.depth, stats.maxSlack);
+    return true;
+  }
+
+  bool checkQueries(const std::string &name, const Test::CollMesh &mesh, float extend, uint32_t seed)
+  {
+    constexpr uint32_t QUERY_COUNT = 2000;
+    auto &bvh = *mesh.mesh->bvh;
+    auto triCount = mesh.mesh->triCount;
+
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> rand{-1.0f, 1.0f};
+    std::vector<uint8_t> found(triCount);
+    uint32_t bvhResults = 0;
+    uint32_t bruteResults = 0;
+
+    // AABB: the BVH may return a few more triangles, but never miss one
+    for(uint32_t q=0; q<QUERY_COUNT; ++q) {
+      AABB query{};
+      for(int i=0; i<3; ++i) {
+        float center = rand(rng) * extend * 1.1f;
+        float size = (rand(rng) + 1.0f) * extend * 0.1f;
+        query.min.v[i] = (int16_t)(center - size);
+        query.max.v[i] = (int16_t)(center + size);
+      }
+
+      std::fill(found.begin(), found.end(), 0);
+      bvh.vsAABB(query, [&](uint32_t t) { ++found[t]; ++bvhResults; });
+
+      for(uint32_t t=0; t<triCount; ++t) {
+        if(found[t] > 1) {
+          printf("[%s] AABB query returned triangle %u twice\n", name.c_str(), t);
+          return false;
+        }
+        if(!getTriangleBounds(mesh, t).vsAABB(query))continue;
+        ++bruteResults;
+        if(!found[t]) {
+          printf("[%s] AABB query missed triangle %u\n", name.c_str(), t);
+          return false;
+        }
+      }
+    }
+
+    // rays: same closest hit, either from above (like floor checks) or in any direction
+    uint32_t hits = 0;
+    for(uint32_t q=0; q<QUERY_COUNT; ++q) {
+      fm_vec3_t pos{{rand(rng) * extend, rand(rng) * extend, rand(rng) * extend}};
+      fm_vec3_t dir{{rand(rng), rand(rng), rand(rng)}};
+      if(q % 2 == 0) {
+        pos.y = extend;
+        dir = {{rand(rng) * 0.2f, -1.0f, rand(rng) * 0.2f}};
+      }
+      fm_vec3_norm(&dir, &dir);
+      auto ray = P64::Coll::Ray::create(pos, dir);
+      float maxDist = (q % 3 == 0) ? INFINITY : extend;
+
+      P64::Coll::RaycastRes resBVH{.dist = maxDist};
+      bvh.raycast(ray, resBVH.dist, [&](uint32_t t) {
+        auto hit = mesh.mesh->vsRay(ray, mesh.getTriangle(t));
+        if(hit.hasResult() && hit.dist < resBVH.dist)resBVH = hit;
+      });
+
+      P64::Coll::RaycastRes resBrute{.dist = maxDist};
+      for(uint32_t t=0; t<triCount; ++t) {
+        auto hit = mesh.mesh->vsRay(ray, mesh.getTriangle(t));
+        if(hit.hasResult() && hit.dist < resBrute.dist)resBrute = hit;
+      }
+
+      hits += resBrute.hasResult();
+      if(resBVH.hasResult() != resBrute.hasResult() || resBVH.dist != resBrute.dist) {
+        printf("[%s] ray %u: BVH hit %d at %f, brute-force hit %d at %f\n", name.c_str(), q,
+          resBVH.hasResult(), resBVH.dist, resBrute.hasResult(), resBrute.dist);
+        return false;
+      }
+    }
+
+    printf("[%s] queries OK: AABB %u/%u triangles (BVH/exact), %u/%u rays hit\n", name.c_str(),
+      bvhResults, bruteResults, hits, QUERY_COUNT);
+    return true;
+  }
+
+  bool checkMesh(const std::string &name, const Test::CollMesh &mesh, float extend, uint32_t seed)
+  {
+    return checkTriangles(name, mesh) && checkTree(name, mesh) && checkQueries(name, mesh, extend, seed);
+  }
+}
+
+P64::Scene &P64::SceneManager::getCurrent() { return gameScene; }
+
+int main()
+{
+  bool ok = true;
+
+  // single triangles, smaller than the min. node size
+  ok &= checkMesh("single triangle", Test::CollMesh{
+    {{{0.0f, 0.0f, 0.0f}}, {{0.0f, 0.0f, 2.0f}}, {{2.0f, 0.0f, 0.0f}}}, {0, 1, 2}, false
+  }, 4.0f, 1);
+
+  for(float extend : {20.0f, 500.0f, 8000.0f}) {
+    for(uint32_t seed=1; seed<=2; ++seed) {
+      auto mesh = Test::createLevelMesh(32, 600, extend, seed, seed == 1);
+      ok &= checkMesh("level " + std::to_string((int)extend) + "/" + std::to_string(seed), *mesh, extend, seed);
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "collision/bvh.h"
+#include "collision/mesh.h"
+#include "../../src/project/assets/collision.h"
+#include "../../src/utils/binaryFile.h"
+
+/**
+ * Creates runtime collision meshes on the host, with the writer of the editor ('Collision::writeMesh').
+ * The big-endian file is converted to host byte order and pointer size, and then loaded through 'Mesh::load'.
+ */
+namespace Test
+{
+  class CollMesh
+  {
+    private:
+      std::vector<uint64_t> data{}; // 64-bit for alignment
+
+      static void swapWords(void *ptr, uint32_t count) {
+        auto words = (uint16_t*)ptr;
+        for(uint32_t i=0; i<count; ++i)words[i] = std::byteswap(words[i]);
+      }
+
+    public:
+      P64::Coll::Mesh *mesh{};
+
+      // input of the mesh, as passed to the constructor
+      std::vector<fm_vec3_t> vertsInput{};
+      std::vector<uint16_t> indicesInput{};
+
+      // vertices of each triangle as the runtime sees them, in the order of 'mesh'
+      std::vector<fm_vec3_t> trisFloat{};
+
+      CollMesh(const std::vector<fm_vec3_t> &vertsFloat, const std::vector<uint16_t> &indices, bool withEdgeNormals)
+        : vertsInput{vertsFloat}, indicesInput{indices}
+      {
+        using namespace P64::Coll;
+
+        std::vector<glm::vec3> verts{};
+        for(auto &v : vertsFloat)verts.push_back({v.x, v.y, v.z});
+        Utils::BinaryFile file{};
+        Project::Assets::Collision::writeMesh(file, verts, indices, withEdgeNormals);
+        auto &fileData = file.getData();
+
+        // header: 32-bit values and pointers in the file, the data after it only contains 16-bit values
+        constexpr uint32_t FILE_HEADER_SIZE = 9 * sizeof(uint32_t);
+        auto readU32 = [&](uint32_t idx) {
+          uint32_t val;
+          memcpy(&val, &fileData[idx * sizeof(uint32_t)], sizeof(val));
+          return std::byteswap(val);
+        };
+
+        data.resize((sizeof(Mesh) + fileData.size() - FILE_HEADER_SIZE + 7) / 8);
+        auto meshRaw = (Mesh*)data.data();
+        meshRaw->version = readU32(0);
+        meshRaw->triCount = readU32(1);
+        meshRaw->vertCount = readU32(2);
+        meshRaw->collScale = std::bit_cast<float>(readU32(3));
+        meshRaw->flags = readU32(4);
+        memcpy(meshRaw->indices, &fileData[FILE_HEADER_SIZE], fileData.size() - FILE_HEADER_SIZE);
+
+        mesh = Mesh::load(meshRaw);
+        swapWords(mesh->indices, mesh->triCount * 3);
+        swapWords(mesh->normals, mesh->triCount * 3);
+        if(mesh->edgeNormals)swapWords(mesh->edgeNormals, mesh->triCount * 9);
+        swapWords(mesh->verts, mesh->vertCount * 3);
+
+        // bounds and node count are plain 16-bit values, the first three values of a node hold its bytes in order
+        swapWords(mesh->bvh, 7);
+        for(uint32_t n=0; n<mesh->bvh->nodeCount; ++n) {
+          swapWords(&mesh->bvh->nodes[n].triCount, 2);
+        }
+
+        for(uint32_t t=0; t<mesh->triCount; ++t) {
+          for(int i=0; i<3; ++i)trisFloat.push_back(mesh->getVert(mesh->indices[t*3 + i]));
+        }
+      }
+
+      CollMesh(const CollMesh&) = delete;
+      CollMesh& operator=(const CollMesh&) = delete;
+
+      // triangle as the collision scene creates it from the mesh data
+      [[nodiscard]] P64::Coll::Triangle getTriangle(uint32_t t) const {
+        auto &norm = mesh->normals[t];
+        return {
+          .normal = {{
+            (float)norm.v[0] * (1.0f / 32767.0f),
+            (float)norm.v[1] * (1.0f / 32767.0f),
+            (float)norm.v[2] * (1.0f / 32767.0f)
+          }},
+          .v = {
+            mesh->getVert(mesh->indices[t*3]),
+            mesh->getVert(mesh->indices[t*3+1]),
+            mesh->getVert(mesh->indices[t*3+2])
+          },
+          .edgeNormals = mesh->edgeNormals ? &mesh->edgeNormals[t*3] : nullptr
+        };
+      }
+  };
+
+  /**
+   * Random level-like geometry: a bumpy floor of quads, plus scattered triangles of different sizes.
+   * Vertex positions are within +-extend.
+   */
+  inline std::unique_ptr<CollMesh> createLevelMesh(uint32_t gridSize, uint32_t extraTris, float extend,
+    uint32_t seed, bool withEdgeNormals = true)
+  {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> rand{-1.0f, 1.0f};
+    std::vector<fm_vec3_t> verts{};
+    std::vector<uint16_t> indices{};
+
+    float cellSize = extend * 2.0f / gridSize;
+    for(uint32_t z=0; z<=gridSize; ++z) {
+      for(uint32_t x=0; x<=gridSize; ++x) {
+        verts.push_back({{-extend + x * cellSize, rand(rng) * cellSize * 0.3f, -extend + z * cellSize}});
+      }
+    }
+    for(uint32_t z=0; z<gridSize; ++z) {
+      for(uint32_t x=0; x<gridSize; ++x) {
+        uint16_t i0 = z * (gridSize+1) + x;
+        uint16_t i1 = i0 + 1;
+        uint16_t i2 = i0 + gridSize + 1;
+        uint16_t i3 = i2 + 1;
+        // counter-clockwise seen from above, so normals point up
+        indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+      }
+    }
+
+    for(uint32_t t=0; t<extraTris; ++t) {
+      fm_vec3_t center{{rand(rng) * extend * 0.9f, rand(rng) * extend * 0.2f, rand(rng) * extend * 0.9f}};
+      float size = cellSize * ((t % 3 == 0) ? 2.0f : 0.5f);
+      for(int i=0; i<3; ++i) {
+        indices.push_back(verts.size());
+        verts.push_back(center + fm_vec3_t{{rand(rng) * size, rand(rng) * size, rand(rng) * size}});
+      }
+    }
+    return std::make_unique<CollMesh>(verts, indices, withEdgeNormals);
+  }
+}
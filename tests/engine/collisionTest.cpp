@@ -0,0 +1,169 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "collision/scene.h"
+#include "collision/flags.h"
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+#include "collMesh.h"
+
+/**
+ * Moves bodies fast enough into a floor and a wall to be caught by the sweep,
+ * and checks that the contact, its flags and the event are reported in that same frame.
+ * Also checks that only bodies without any velocity fall asleep.
+ */
+namespace
+{
+  P64::Scene gameScene{};
+
+  constexpr float DELTA_TIME = 1.0f / 30.0f;
+  constexpr float TOLERANCE = 0.2f;
+
+  // floor at y=0 and a wall at x=50 facing -X, both 200 units wide
+  std::unique_ptr<Test::CollMesh> createRoom()
+  {
+    std::vector<fm_vec3_t> verts{
+      {{-100.0f, 0.0f, -100.0f}}, {{100.0f, 0.0f, -100.0f}}, {{-100.0f, 0.0f, 100.0f}}, {{100.0f, 0.0f, 100.0f}},
+      {{50.0f, -100.0f, -100.0f}}, {{50.0f, -100.0f, 100.0f}}, {{50.0f, 100.0f, -100.0f}}, {{50.0f, 100.0f, 100.0f}},
+    };
+    std::vector<uint16_t> indices{0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6};
+    return std::make_unique<Test::CollMesh>(verts, indices, true);
+  }
+
+  struct Body
+  {
+    P64::Object obj{};
+    P64::Coll::BCS bcs{};
+  };
+
+  bool check(const std::string &name, bool ok)
+  {
+    printf("[%s] %s\n", name.c_str(), ok ? "OK" : "FAILED");
+    return ok;
+  }
+
+  // runs a single frame with one body, returns if the expected contact was reported
+  bool checkContact(const std::string &name, Body &body, uint8_t expectedType, const fm_vec3_t &expectedPos)
+  {
+    auto room = createRoom();
+    P64::Object roomObj{};
+    P64::Coll::MeshInstance roomInst{.mesh = room->mesh, .object = &roomObj};
+
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&roomInst);
+    body.obj.collCompMask = 1;
+    body.bcs.obj = &body.obj;
+    scene.registerBCS(&body.bcs);
+
+    gameScene.collEvents.clear();
+    scene.update(DELTA_TIME);
+
+    auto &pos = body.bcs.center;
+    bool posOk = fabsf(pos.x - expectedPos.x) < TOLERANCE
+      && fabsf(pos.y - expectedPos.y) < TOLERANCE
+      && fabsf(pos.z - expectedPos.z) < TOLERANCE;
+
+    bool eventOk = gameScene.collEvents.size() == 1
+      && gameScene.collEvents[0].selfBCS == &body.bcs
+      && gameScene.collEvents[0].otherMesh == &roomInst;
+
+    bool ok = (body.bcs.hitTriTypes & expectedType) && posOk && eventOk;
+    if(!ok) {
+      printf("[%s] pos: %.3f %.3f %.3f, flags: %d, events: %d\n", name.c_str(),
+        pos.x, pos.y, pos.z, body.bcs.hitTriTypes, (int)gameScene.collEvents.size());
+    }
+    return check(name, ok);
+  }
+
+  // runs multiple frames with gravity, checks the sleep state at the end
+  bool checkSleep(const std::string &name, Body &body, int frames, bool expectSleep, const fm_vec3_t &expectedPos)
+  {
+    auto room = createRoom();
+    P64::Object roomObj{};
+    P64::Coll::MeshInstance roomInst{.mesh = room->mesh, .object = &roomObj};
+
+    P64::Coll::Scene scene{};
+    scene.registerMesh(&roomInst);
+    body.bcs.obj = &body.obj;
+    scene.registerBCS(&body.bcs);
+
+    for(int f=0; f<frames; ++f) {
+      body.bcs.velocity.v[1] -= 9.81f * DELTA_TIME;
+      scene.update(DELTA_TIME);
+    }
+
+    auto &pos = body.bcs.center;
+    bool posOk = fabsf(pos.x - expectedPos.x) < TOLERANCE
+      && fabsf(pos.y - expectedPos.y) < TOLERANCE
+      && fabsf(pos.z - expectedPos.z) < TOLERANCE;
+
+    bool ok = scene.isSleeping(&body.bcs) == expectSleep && posOk;
+    if(!ok) {
+      printf("[%s] pos: %.3f %.3f %.3f, sleeping: %d\n", name.c_str(),
+        pos.x, pos.y, pos.z, scene.isSleeping(&body.bcs));
+    }
+    return check(name, ok);
+  }
+}
+
+P64::Scene &P64::SceneManager::getCurrent() { return gameScene; }
+
+int main()
+{
+  using namespace P64::Coll;
+  bool ok = true;
+
+  { // falls 20 units in one frame, hits the floor after 15
+    Body body{};
+    body.bcs.center = {{0.0f, 20.0f, 0.0f}};
+    body.bcs.halfExtend = {{5.0f, 5.0f, 5.0f}};
+    body.bcs.velocity = {{0.0f, -20.0f / DELTA_TIME, 0.0f}};
+    ok &= checkContact("sphere vs. floor", body, TriType::FLOOR, {{0.0f, 5.0f, 0.0f}});
+  }
+
+  { // same but also moving sideways, the rest of the motion after the impact slides along the floor
+    Body body{};
+    body.bcs.center = {{-40.0f, 20.0f, 0.0f}};
+    body.bcs.halfExtend = {{5.0f, 5.0f, 5.0f}};
+    body.bcs.velocity = {{20.0f / DELTA_TIME, -20.0f / DELTA_TIME, 0.0f}};
+    ok &= checkContact("sphere slides on floor", body, TriType::FLOOR, {{-20.0f, 5.0f, 0.0f}});
+  }
+
+  { // flies into the wall, ends up touching it
+    Body body{};
+    body.bcs.center = {{0.0f, 30.0f, 0.0f}};
+    body.bcs.halfExtend = {{5.0f, 5.0f, 5.0f}};
+    body.bcs.velocity = {{80.0f / DELTA_TIME, 0.0f, 0.0f}};
+    ok &= checkContact("sphere vs. wall", body, TriType::WALL, {{45.0f, 30.0f, 0.0f}});
+  }
+
+  { // boxes already overlap at their time of impact
+    Body body{};
+    body.bcs.center = {{0.0f, 30.0f, 0.0f}};
+    body.bcs.halfExtend = {{4.0f, 4.0f, 4.0f}};
+    body.bcs.flags = BCSFlags::SHAPE_BOX;
+    body.bcs.velocity = {{0.0f, -40.0f / DELTA_TIME, 0.0f}};
+    ok &= checkContact("box vs. floor", body, TriType::FLOOR, {{0.0f, 4.0f, 0.0f}});
+  }
+
+  { // slower than the sleep threshold per frame, must keep sliding instead of falling asleep
+    Body body{};
+    body.bcs.center = {{0.0f, 5.0f, 0.0f}};
+    body.bcs.halfExtend = {{5.0f, 5.0f, 5.0f}};
+    body.bcs.velocity = {{0.5f, 0.0f, 0.0f}};
+    ok &= checkSleep("slow body keeps moving", body, 120, false, {{2.0f, 5.0f, 0.0f}});
+  }
+
+  { // resting on the floor with gravity, falls asleep and stays there
+    Body body{};
+    body.bcs.center = {{0.0f, 5.0f, 0.0f}};
+    body.bcs.halfExtend = {{5.0f, 5.0f, 5.0f}};
+    ok &= checkSleep("resting body sleeps", body, 120, true, {{0.0f, 5.0f, 0.0f}});
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "scene/componentTable.h"
+#include "scene/objectFlags.h"
+#include "scene/components/camera.h"
+#include "scene/components/culling.h"
+#include "scene/components/light.h"
+#include "scene/components/model.h"
+
+/**
+ * Compares the two ways the scene can run component updates and draws:
+ * - object-major: every object walks its component references and calls each update/draw (the old loop)
+ * - type-major: one list per component type, in the order of 'COMP_ORDER_UPDATE' / 'COMP_ORDER_DRAW' (the current loop)
+ *
+ * This links the engine's 'componentTable.cpp', with the components replaced by the stand-ins in 'engine/host'.
+ * So the table, which types have an update/draw, and the type order are the real ones, only the work itself is not.
+ * The scene needs libdragon, so objects are allocated here with the same layout as the scene arena:
+ * each object is followed by its component references and data.
+ * Usage: benchCompOrder [object-count ...]
+ */
+namespace
+{
+  using namespace P64;
+  using Clock = std::chrono::steady_clock;
+
+  // same as 'Object::CompRef'
+  struct CompRef
+  {
+    uint8_t type{};
+    uint8_t flags{};
+    uint16_t offset{};
+  };
+
+  struct SceneObject : Object
+  {
+    uint16_t compCount{};
+  };
+
+  CompRef* getCompRefs(SceneObject &obj) {
+    return (CompRef*)((uint8_t*)&obj + sizeof(SceneObject));
+  }
+
+  // the old loop also called these empty functions, they were removed with the type-major loop
+  void updateStub(Object&, void*, float) {}
+  void drawStub(Object&, void*, float) {}
+  constexpr std::array OLD_UPDATE_STUBS{Comp::Model::ID, Comp::Culling::ID};
+  constexpr std::array OLD_DRAW_STUBS{Comp::Camera::ID, Comp::Light::ID};
+
+  FuncUpdate oldUpdate[COMP_TABLE_SIZE]{};
+  FuncDraw oldDraw[COMP_TABLE_SIZE]{};
+
+  void initOldTable()
+  {
+    for(uint32_t type=0; type<COMP_TABLE_SIZE; ++type) {
+      oldUpdate[type] = COMP_TABLE[type].update;
+      oldDraw[type] = COMP_TABLE[type].draw;
+    }
+    for(auto type : OLD_UPDATE_STUBS)oldUpdate[type] = updateStub;
+    for(auto type : OLD_DRAW_STUBS)oldDraw[type] = drawStub;
+  }
+
+  // typical object setups by component ID, most are static models.
+  // components within one object don't depend on each other, so both orders must give the same result.
+  const std::vector<std::vector<uint8_t>> PREFABS = {
+    {8, 1}, {8, 1}, {8, 1}, {8, 1, 4}, {8, 1, 4},
+    {8, 0, 1}, {0, 10, 5}, {0, 10, 5, 6}, {7, 1}, {2}, {8, 9, 1}, {0}, {3},
+  };
+
+  struct CompInstance
+  {
+    Object *obj;
+    void *data;
+    bool active;
+  };
+
+  struct World
+  {
+    std::unique_ptr<uint8_t[]> arena{};
+    std::vector<SceneObject*> objects{};
+    std::array<std::vector<CompInstance>, COMP_TABLE_SIZE> updateList{};
+    std::array<std::vector<CompInstance>, COMP_TABLE_SIZE> drawList{};
+    bool activeDirty{false};
+
+    explicit World(uint32_t objCount, uint32_t seed)
+    {
+      // sorted by priority like the scene builder does
+      auto prefabs = PREFABS;
+      for(auto &types : prefabs) {
+        std::stable_sort(types.begin(), types.end(), [](uint8_t a, uint8_t b) {
+          return COMP_TABLE[a].prio < COMP_TABLE[b].prio;
+        });
+      }
+
+      std::mt19937 rng{seed};
+      std::vector<const std::vector<uint8_t>*> setups{};
+      uint32_t arenaSize = 0;
+      for(uint32_t i=0; i<objCount; ++i) {
+        setups.push_back(&prefabs[rng() % prefabs.size()]);
+        arenaSize += sizeof(SceneObject) + setups.back()->size() * sizeof(CompRef);
+        for(auto type : *setups.back())arenaSize += COMP_TABLE[type].getAllocSize(nullptr);
+        arenaSize = (arenaSize + 15) & ~15;
+      }
+      arena = std::make_unique<uint8_t[]>(arenaSize);
+      memset(arena.get(), 0, arenaSize);
+
+      uint32_t offset = 0;
+      for(uint32_t i=0; i<objCount; ++i) {
+        auto &types = *setups[i];
+        auto obj = new(&arena[offset]) SceneObject();
+        obj->id = i + 1;
+        obj->flags = (i % 16 == 0) ? 0 : ObjectFlags::ACTIVE;
+        obj->pos.x = (float)(rng() % 200) - 100.0f;
+        obj->pos.y = (float)(rng() % 50);
+        obj->compCount = types.size();
+
+        // same as 'Scene::addToCompLists'
+        auto refs = getCompRefs(*obj);
+        uint16_t dataOffset = sizeof(SceneObject) + types.size() * sizeof(CompRef);
+        for(uint32_t c=0; c<types.size(); ++c) {
+          auto type = types[c];
+          auto data = (uint8_t*)obj + dataOffset;
+          refs[c] = {.type = type, .offset = dataOffset};
+          *(float*)data = (float)(rng() % 8); // first member of each stand-in
+
+          CompInstance comp{obj, data, (obj->flags & ObjectFlags::ACTIVE) == ObjectFlags::ACTIVE};
+          if(COMP_TABLE[type].update)updateList[type].push_back(comp);
+          if(COMP_TABLE[type].draw)drawList[type].push_back(comp);
+          dataOffset += COMP_TABLE[type].getAllocSize(nullptr);
+        }
+        objects.push_back(obj);
+        offset = (offset + dataOffset + 15) & ~15;
+      }
+    }
+
+    void frameObjectMajor(float dt)
+    {
+      for(auto obj : objects) {
+        if((obj->flags & ObjectFlags::ACTIVE) != ObjectFlags::ACTIVE)continue;
+        auto refs = getCompRefs(*obj);
+        for(uint32_t c=0; c<obj->compCount; ++c) {
+          auto func = oldUpdate[refs[c].type];
+          if(func)func(*obj, (uint8_t*)obj + refs[c].offset, dt);
+        }
+      }
+
+      for(auto obj : objects) {
+        if((obj->flags & ObjectFlags::ACTIVE) != ObjectFlags::ACTIVE)continue;
+        auto refs = getCompRefs(*obj);
+        for(uint32_t c=0; c<obj->compCount; ++c) {
+          if(obj->flags & ObjectFlags::IS_CULLED)break;
+          auto func = oldDraw[refs[c].type];
+          if(func)func(*obj, (uint8_t*)obj + refs[c].offset, dt);
+        }
+      }
+      for(auto obj : objects)obj->flags &= ~ObjectFlags::IS_CULLED;
+    }
+
+    void syncActive()
+    {
+      activeDirty = false;
+      for(auto &list : updateList) {
+        for(auto &comp : list)comp.active = (comp.obj->flags & ObjectFlags::ACTIVE) == ObjectFlags::ACTIVE;
+      }
+      for(auto &list : drawList) {
+        for(auto &comp : list)comp.active = (comp.obj->flags & ObjectFlags::ACTIVE) == ObjectFlags::ACTIVE;
+      }
+    }
+
+    // same loops as 'Scene::update' / 'Scene::draw', the active state never changes here
+    void frameTypeMajor(float dt)
+    {
+      for(auto type : COMP_ORDER_UPDATE) {
+        auto funcUpdate = COMP_TABLE[type].update;
+        for(auto &comp : updateList[type]) {
+          if(activeDirty)syncActive();
+          if(comp.active)funcUpdate(*comp.obj, comp.data, dt);
+        }
+      }
+
+      for(auto type : COMP_ORDER_DRAW) {
+        auto funcDraw = COMP_TABLE[type].draw;
+        for(auto &comp : drawList[type]) {
+          if(activeDirty)syncActive();
+          if(comp.active && !(comp.obj->flags & ObjectFlags::IS_CULLED)) {
+            funcDraw(*comp.obj, comp.data, dt);
+          }
+        }
+      }
+      for(auto obj : objects)obj->flags &= ~ObjectFlags::IS_CULLED;
+    }
+
+    [[nodiscard]] double checksum() const {
+      double res = 0.0;
+      for(auto obj : objects) {
+        res += obj->pos.x + obj->pos.y * 3.0;
+        auto refs = getCompRefs(*obj);
+        for(uint32_t c=0; c<obj->compCount; ++c) {
+          res += *(float*)((uint8_t*)obj + refs[c].offset) * 7.0;
+        }
+      }
+      return res;
+    }
+  };
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<uint32_t> counts{};
+  for(int i=1; i<argc; ++i)counts.push_back(std::stoul(argv[i]));
+  if(counts.empty())counts = {64, 256, 1024, 4096};
+
+  constexpr int FRAMES = 2000;
+  constexpr float DELTA_TIME = 1.0f / 30.0f;
+  bool allMatch = true;
+  initOldTable();
+
+  printf("Update order:");
+  for(auto type : COMP_ORDER_UPDATE)printf(" %d", type);
+  printf("\nDraw order:  ");
+  for(auto type : COMP_ORDER_DRAW)printf(" %d", type);
+  printf("\n\n");
+
+  printf("%8s %18s %18s %8s\n", "Objects", "object-major (us)", "type-major (us)", "Speedup");
+  for(auto count : counts)
+  {
+    World worldObj{count, count};
+    World worldType{count, count};
+
+    auto t0 = Clock::now();
+    for(int f=0; f<FRAMES; ++f)worldObj.frameObjectMajor(DELTA_TIME);
+    auto t1 = Clock::now();
+    for(int f=0; f<FRAMES; ++f)worldType.frameTypeMajor(DELTA_TIME);
+    auto t2 = Clock::now();
+
+    // culling happens before any model draws in both, so they must end up in the same state
+    allMatch &= worldObj.checksum() == worldType.checksum();
+
+    double usObj = std::chrono::duration<double, std::micro>(t1 - t0).count() / FRAMES;
+    double usType = std::chrono::duration<double, std::micro>(t2 - t1).count() / FRAMES;
+    printf("%8u %18.2f %18.2f %7.2fx\n", count, usObj, usType, usObj / usType);
+  }
+
+  if(!allMatch) {
+    printf("Error: both layouts must give the same result\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include "scene/objectHierarchy.h"
+
+/**
+ * Spawns objects under random parents and deletes random batches over many rounds, the same way the scene does:
+ * all objects of a batch get unlinked before any is destroyed, with parents and their children in either order.
+ * After each step the child lists must match a plain list per parent, in spawn order.
+ */
+using namespace P64;
+
+namespace
+{
+  struct Node
+  {
+    uint16_t id{};
+    uint16_t group{};
+    Node *firstChild{nullptr};
+    Node *nextSibling{nullptr};
+    Node *prevSibling{nullptr};
+  };
+
+  struct World
+  {
+    std::vector<std::unique_ptr<Node>> nodes{}; // by ID, nullptr once deleted
+    Node *rootFirstChild{nullptr};
+    std::vector<std::vector<uint16_t>> expected{}; // children per parent ID, 0 is the root
+
+    World() {
+      nodes.emplace_back(); // ID 0 is the root, never an object
+      expected.emplace_back();
+    }
+
+    Node** getChildList(uint16_t parentId) {
+      if(parentId == 0)return &rootFirstChild;
+      auto &parent = nodes[parentId];
+      return parent ? &parent->firstChild : nullptr;
+    }
+
+    bool isAlive(uint16_t id) const { return id != 0 && nodes[id]; }
+
+    void spawn(uint16_t parentId)
+    {
+      uint16_t id = nodes.size();
+      nodes.push_back(std::make_unique<Node>(Node{.id = id, .group = parentId}));
+      expected.emplace_back();
+      ObjectHierarchy::link(*nodes[id], [this](uint16_t p) { return getChildList(p); });
+      if(parentId == 0 || isAlive(parentId))expected[parentId].push_back(id);
+    }
+
+    void deleteBatch(const std::vector<uint16_t> &ids)
+    {
+      for(auto id : ids) {
+        ObjectHierarchy::unlink(*nodes[id], [this](uint16_t p) { return getChildList(p); });
+      }
+      for(auto id : ids) {
+        std::erase(expected[nodes[id]->group], id);
+        expected[id].clear(); // children stay without a parent
+      }
+      for(auto id : ids)nodes[id].reset();
+    }
+
+    bool checkList(uint16_t parentId, Node* first) const
+    {
+      std::vector<uint16_t> ids{};
+      ObjectHierarchy::iterChildren(first, [&](Node* child) { ids.push_back(child->id); });
+      if(ids != expected[parentId]) {
+        printf("Parent %d: %zu children, expected %zu\n", parentId, ids.size(), expected[parentId].size());
+        return false;
+      }
+      if(!first)return true;
+
+      // the first child points to the last one, all others to their previous sibling
+      Node* prev = nullptr;
+      for(auto child = first; child; child = child->nextSibling) {
+        if(child != first && child->prevSibling != prev) {
+          printf("Parent %d: broken back-link at %d\n", parentId, child->id);
+          return false;
+        }
+        prev = child;
+      }
+      if(first->prevSibling != prev) {
+        printf("Parent %d: first child doesn't point to the last one\n", parentId);
+        return false;
+      }
+      return true;
+    }
+
+    bool check() const
+    {
+      if(!checkList(0, rootFirstChild))return false;
+      for(uint32_t id=1; id<nodes.size(); ++id) {
+        if(nodes[id] && !checkList(id, nodes[id]->firstChild))return false;
+      }
+      return true;
+    }
+  };
+}
+
+int main()
+{
+  std::mt19937 rng{42};
+  World world{};
+
+  uint32_t deleteCount = 0;
+  for(uint32_t round=0; round<500; ++round)
+  {
+    std::vector<uint16_t> alive{};
+    for(uint32_t id=1; id<world.nodes.size(); ++id) {
+      if(world.nodes[id])alive.push_back(id);
+    }
+
+    // spawn under the root, a live object, or a deleted one (which leaves it without a parent)
+    uint32_t spawnCount = 1 + rng() % 24;
+    for(uint32_t i=0; i<spawnCount; ++i) {
+      uint16_t parentId = 0;
+      auto r = rng() % 8;
+      if(r >= 2 && !alive.empty())parentId = alive[rng() % alive.size()];
+      else if(r == 1 && world.nodes.size() > 1)parentId = 1 + rng() % (world.nodes.size() - 1);
+      world.spawn(parentId);
+      if(!world.check()) { printf("Round %u: spawn failed\n", round); return 1; }
+    }
+
+    // delete random objects, often together with their parent or a child
+    std::vector<uint16_t> batch{};
+    for(uint32_t i=0; i<alive.size() / 8; ++i) {
+      auto id = alive[rng() % alive.size()];
+      batch.push_back(id);
+      auto &node = *world.nodes[id];
+      if(rng() % 2 && world.isAlive(node.group))batch.push_back(node.group);
+      if(rng() % 2 && node.firstChild)batch.push_back(node.firstChild->prevSibling->id);
+    }
+    std::sort(batch.begin(), batch.end());
+    batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+    std::shuffle(batch.begin(), batch.end(), rng);
+
+    world.deleteBatch(batch);
+    deleteCount += batch.size();
+    if(!world.check()) { printf("Round %u: delete failed\n", round); return 1; }
+  }
+
+  // the object being visited may be unlinked in the callback, e.g. to remove all children of a parent
+  std::vector<uint16_t> visited{};
+  auto expectedRoot = world.expected[0];
+  ObjectHierarchy::iterChildren(world.rootFirstChild, [&](Node* child) {
+    visited.push_back(child->id);
+    ObjectHierarchy::unlink(*child, [&](uint16_t p) { return world.getChildList(p); });
+  });
+  if(visited != expectedRoot || world.rootFirstChild) {
+    printf("Unlinking while iterating visited %zu of %zu\n", visited.size(), expectedRoot.size());
+    return 1;
+  }
+
+  printf("OK, %zu objects spawned and %u deleted\n", world.nodes.size() - 1, deleteCount);
+  return 0;
+}
@@ -0,0 +1,14 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+
+// Host stand-in, drawing is not needed in tests
+namespace P64::Debug
+{
+  inline void drawLine(const fm_vec3_t&, const fm_vec3_t&, color_t) {}
+  inline void drawAABB(const fm_vec3_t&, const fm_vec3_t&, color_t) {}
+  inline void drawSphere(const fm_vec3_t&, float, color_t) {}
+}
@@ -0,0 +1,84 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Host stand-in for the parts of libdragon used by the engine code under test.
+ * Math follows 'fmath.h', everything hardware related is either a NOP or uses the C library.
+ */
+
+#define assertf(cond, ...) assert(cond)
+#define debugf(...) printf(__VA_ARGS__)
+
+typedef struct { uint8_t r, g, b, a; } color_t;
+
+typedef union { struct { float x, y; }; float v[2]; } fm_vec2_t;
+typedef union { struct { float x, y, z; }; float v[3]; } fm_vec3_t;
+typedef union { struct { float x, y, z, w; }; float v[4]; } fm_quat_t;
+
+inline uint64_t get_ticks() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline void* memalign(size_t align, size_t size) {
+  return aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+inline float fm_sinf(float x) { return sinf(x); }
+
+inline float fm_vec2_dot(const fm_vec2_t *a, const fm_vec2_t *b) { return a->x * b->x + a->y * b->y; }
+
+inline float fm_vec3_dot(const fm_vec3_t *a, const fm_vec3_t *b) { return a->x * b->x + a->y * b->y + a->z * b->z; }
+inline float fm_vec3_len2(const fm_vec3_t *a) { return fm_vec3_dot(a, a); }
+inline float fm_vec3_len(const fm_vec3_t *a) { return sqrtf(fm_vec3_len2(a)); }
+
+inline void fm_vec3_cross(fm_vec3_t *out, const fm_vec3_t *a, const fm_vec3_t *b) {
+  *out = {{a->y * b->z - a->z * b->y, a->z * b->x - a->x * b->z, a->x * b->y - a->y * b->x}};
+}
+
+inline void fm_vec3_norm(fm_vec3_t *out, const fm_vec3_t *a) {
+  float len = fm_vec3_len(a);
+  if(len < 1e-20f) { *out = {}; return; }
+  *out = {{a->x / len, a->y / len, a->z / len}};
+}
+
+inline void fm_quat_inverse(fm_quat_t *out, const fm_quat_t *q) {
+  float len2 = q->x * q->x + q->y * q->y + q->z * q->z + q->w * q->w;
+  *out = {{-q->x / len2, -q->y / len2, -q->z / len2, q->w / len2}};
+}
+
+inline void fm_quat_from_axis_angle(fm_quat_t *out, const fm_vec3_t *axis, float angle) {
+  float s = sinf(angle * 0.5f);
+  *out = {{axis->x * s, axis->y * s, axis->z * s, cosf(angle * 0.5f)}};
+}
+
+inline fm_vec3_t operator+(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x + b.x, a.y + b.y, a.z + b.z}}; }
+inline fm_vec3_t operator-(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x - b.x, a.y - b.y, a.z - b.z}}; }
+inline fm_vec3_t operator*(const fm_vec3_t &a, const fm_vec3_t &b) { return {{a.x * b.x, a.y * b.y, a.z * b.z}}; }
+inline fm_vec3_t operator*(const fm_vec3_t &a, float s) { return {{a.x * s, a.y * s, a.z * s}}; }
+inline fm_vec3_t operator*(float s, const fm_vec3_t &a) { return a * s; }
+inline fm_vec3_t operator/(const fm_vec3_t &a, float s) { return a * (1.0f / s); }
+inline fm_vec3_t operator-(const fm_vec3_t &a) { return {{-a.x, -a.y, -a.z}}; }
+inline fm_vec3_t& operator+=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a + b; }
+inline fm_vec3_t& operator-=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a - b; }
+inline fm_vec3_t& operator*=(fm_vec3_t &a, const fm_vec3_t &b) { return a = a * b; }
+inline fm_vec3_t& operator*=(fm_vec3_t &a, float s) { return a = a * s; }
+
+// rotates a vector by a unit quaternion
+inline fm_vec3_t operator*(const fm_quat_t &q, const fm_vec3_t &v) {
+  fm_vec3_t qv{{q.x, q.y, q.z}};
+  fm_vec3_t t, c;
+  fm_vec3_cross(&t, &qv, &v);
+  t = t * 2.0f;
+  fm_vec3_cross(&c, &qv, &t);
+  return v + t * q.w + c;
+}
@@ -0,0 +1,31 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'AnimModel' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct AnimModel
+  {
+    static constexpr uint32_t ID = 10;
+
+    float time{};
+    float drawCount{};
+    float mat[16]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(AnimModel); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] AnimModel* data, [[maybe_unused]] void* initData) {}
+
+    static void update([[maybe_unused]] Object& obj, AnimModel* data, float deltaTime) {
+      data->time += deltaTime;
+    }
+
+    static void draw(Object& obj, AnimModel* data, [[maybe_unused]] float deltaTime) {
+      data->mat[12] = obj.pos.x * obj.scale.x + data->time;
+      data->drawCount += 1.0f;
+    }
+  };
+}
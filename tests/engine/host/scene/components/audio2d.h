@@ -0,0 +1,24 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'Audio2D' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Audio2D
+  {
+    static constexpr uint32_t ID = 6;
+
+    float time{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Audio2D); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Audio2D* data, [[maybe_unused]] void* initData) {}
+
+    static void update([[maybe_unused]] Object& obj, Audio2D* data, float deltaTime) {
+      data->time += deltaTime;
+    }
+  };
+}
@@ -0,0 +1,27 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'Camera' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Camera
+  {
+    static constexpr uint32_t ID = 3;
+
+    float fov{};
+    fm_vec3_t pos{};
+    float mat[16]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Camera); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Camera* data, [[maybe_unused]] void* initData) {}
+
+    static void update(Object& obj, Camera* data, [[maybe_unused]] float deltaTime) {
+      obj.pos = data->pos;
+      data->fov += 1.0f;
+    }
+  };
+}
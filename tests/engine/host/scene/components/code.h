@@ -0,0 +1,31 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'Code' with the same ID, priority and update/draw functions, the work is a placeholder.
+// The first member is what the benchmark adds to its checksum.
+namespace P64::Comp
+{
+  struct Code
+  {
+    static constexpr uint32_t ID = 0;
+
+    float time{};
+    float vel[3]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Code); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Code* data, [[maybe_unused]] void* initData) {}
+
+    static void update(Object& obj, Code* data, float deltaTime) {
+      data->time += deltaTime;
+      obj.pos.x += data->vel[0] * deltaTime;
+    }
+
+    static void draw([[maybe_unused]] Object& obj, Code* data, [[maybe_unused]] float deltaTime) {
+      data->time *= 0.5f;
+    }
+  };
+}
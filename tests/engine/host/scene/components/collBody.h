@@ -0,0 +1,27 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'CollBody' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct CollBody
+  {
+    static constexpr uint32_t ID = 5;
+
+    float velY{};
+    float shape[12]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(CollBody); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] CollBody* data, [[maybe_unused]] void* initData) {}
+
+    static void update(Object& obj, CollBody* data, float deltaTime) {
+      data->velY -= 9.81f * deltaTime;
+      obj.pos.y += data->velY * deltaTime;
+      if(obj.pos.y < 0.0f) { obj.pos.y = 0.0f; data->velY = 0.0f; }
+    }
+  };
+}
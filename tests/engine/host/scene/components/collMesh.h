@@ -0,0 +1,25 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'CollMesh' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct CollMesh
+  {
+    static constexpr uint32_t ID = 4;
+
+    float time{};
+    float bounds[8]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(CollMesh); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] CollMesh* data, [[maybe_unused]] void* initData) {}
+
+    static void update([[maybe_unused]] Object& obj, CollMesh* data, float deltaTime) {
+      data->time += deltaTime;
+    }
+  };
+}
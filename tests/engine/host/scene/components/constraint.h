@@ -0,0 +1,32 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+#include "scene/componentPrio.h"
+
+// Host stand-in for 'Constraint' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Constraint
+  {
+    static constexpr uint32_t ID = 7;
+    static constexpr int8_t PRIO = CompPrio::CONSTRAINT;
+    static constexpr int8_t PRIO_UPDATE = CompPrio::CONSTRAINT_UPDATE;
+
+    float offsetY{};
+    fm_vec3_t localRefPos{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Constraint); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Constraint* data, [[maybe_unused]] void* initData) {}
+
+    static void update(Object& obj, Constraint* data, [[maybe_unused]] float deltaTime) {
+      obj.pos.y += data->offsetY;
+    }
+
+    static void draw(Object& obj, Constraint* data, [[maybe_unused]] float deltaTime) {
+      data->offsetY = obj.pos.y * 0.001f;
+    }
+  };
+}
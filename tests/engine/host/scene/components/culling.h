@@ -0,0 +1,28 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+#include "scene/componentPrio.h"
+#include "scene/objectFlags.h"
+
+// Host stand-in for 'Culling' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Culling
+  {
+    static constexpr uint32_t ID = 8;
+    static constexpr int8_t PRIO = CompPrio::CULLING;
+
+    float halfExtend{};
+    fm_vec3_t offset{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Culling); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Culling* data, [[maybe_unused]] void* initData) {}
+
+    static void draw(Object& obj, Culling* data, [[maybe_unused]] float deltaTime) {
+      if(obj.pos.x + data->halfExtend < -50.0f)obj.flags |= ObjectFlags::IS_CULLED;
+    }
+  };
+}
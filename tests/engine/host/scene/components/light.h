@@ -0,0 +1,25 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'Light' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Light
+  {
+    static constexpr uint32_t ID = 2;
+
+    float intensity{};
+    float color[4]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Light); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Light* data, [[maybe_unused]] void* initData) {}
+
+    static void update([[maybe_unused]] Object& obj, Light* data, [[maybe_unused]] float deltaTime) {
+      data->intensity += data->color[0];
+    }
+  };
+}
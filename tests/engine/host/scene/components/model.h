@@ -0,0 +1,28 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'Model' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct Model
+  {
+    static constexpr uint32_t ID = 1;
+
+    float drawCount{};
+    float mat[16]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(Model); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] Model* data, [[maybe_unused]] void* initData) {}
+
+    static void draw(Object& obj, Model* data, [[maybe_unused]] float deltaTime) {
+      data->mat[12] = obj.pos.x * obj.scale.x;
+      data->mat[13] = obj.pos.y * obj.scale.y;
+      data->mat[14] = obj.pos.z * obj.scale.z;
+      data->drawCount += 1.0f;
+    }
+  };
+}
@@ -0,0 +1,25 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in for 'NodeGraph' with the same ID, priority and update/draw functions, the work is a placeholder.
+namespace P64::Comp
+{
+  struct NodeGraph
+  {
+    static constexpr uint32_t ID = 9;
+
+    float time{};
+    uint32_t state[6]{};
+
+    static uint32_t getAllocSize([[maybe_unused]] void* initData) { return sizeof(NodeGraph); }
+    static void initDelete([[maybe_unused]] Object& obj, [[maybe_unused]] NodeGraph* data, [[maybe_unused]] void* initData) {}
+
+    static void update([[maybe_unused]] Object& obj, NodeGraph* data, float deltaTime) {
+      data->time += deltaTime;
+    }
+  };
+}
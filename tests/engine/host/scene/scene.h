@@ -0,0 +1,32 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <vector>
+#include "collision/scene.h"
+
+// Host stand-in with just the members the collision code and component stand-ins use, events are recorded for tests to check
+namespace P64
+{
+  class Object
+  {
+    public:
+      uint16_t id{};
+      uint16_t flags{};
+      uint32_t collCompMask{0};
+      fm_quat_t rot{{0.0f, 0.0f, 0.0f, 1.0f}};
+      fm_vec3_t pos{};
+      fm_vec3_t scale{{1.0f, 1.0f, 1.0f}};
+  };
+
+  class Scene
+  {
+    public:
+      std::vector<Coll::CollEvent> collEvents{};
+
+      void onObjectCollision(const Coll::CollEvent &event) {
+        collEvents.push_back(event);
+      }
+  };
+}
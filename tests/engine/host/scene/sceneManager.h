@@ -0,0 +1,12 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include "scene/scene.h"
+
+// Host stand-in, tests provide the scene
+namespace P64::SceneManager
+{
+  Scene &getCurrent();
+}
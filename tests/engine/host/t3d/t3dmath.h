@@ -0,0 +1,25 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#pragma once
+#include <libdragon.h>
+
+// Host stand-in for the tiny3d vector functions used by the engine, see 'libdragon.h' next to it
+
+inline float t3d_vec3_dot(const fm_vec3_t *a, const fm_vec3_t *b) { return fm_vec3_dot(a, b); }
+inline float t3d_vec3_dot(const fm_vec3_t &a, const fm_vec3_t &b) { return fm_vec3_dot(&a, &b); }
+inline float t3d_vec3_len2(const fm_vec3_t *a) { return fm_vec3_len2(a); }
+inline float t3d_vec3_len2(const fm_vec3_t &a) { return fm_vec3_len2(&a); }
+inline float t3d_vec3_len(const fm_vec3_t *a) { return fm_vec3_len(a); }
+inline float t3d_vec3_len(const fm_vec3_t &a) { return fm_vec3_len(&a); }
+
+inline float t3d_vec3_distance2(const fm_vec3_t *a, const fm_vec3_t *b) {
+  auto diff = *a - *b;
+  return fm_vec3_len2(&diff);
+}
+inline float t3d_vec3_distance(const fm_vec3_t *a, const fm_vec3_t *b) {
+  return sqrtf(t3d_vec3_distance2(a, b));
+}
+
+inline void t3d_vec3_norm(fm_vec3_t *v) { fm_vec3_norm(v, v); }
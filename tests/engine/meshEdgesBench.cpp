@@ -0,0 +1,137 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "collision/flags.h"
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+#include "collMesh.h"
+
+/**
+ * Runs the triangle tests (sphere, box, sweep) on shapes close to a triangle,
+ * once with the precomputed edge-planes and once with the barycentric fallback.
+ * Reports the time per test of both, and checks that they agree.
+ */
+namespace
+{
+  P64::Scene gameScene{};
+  using Clock = std::chrono::steady_clock;
+
+  struct Pair
+  {
+    P64::Coll::BCS bcs{};
+    fm_vec3_t motion{};
+    uint32_t tri{};
+  };
+
+  struct Result
+  {
+    double nsPerTest{};
+    uint32_t hits{};
+    std::vector<fm_vec3_t> penetration{};
+  };
+
+  template<typename F>
+  Result run(const std::vector<Pair> &pairs, const Test::CollMesh &mesh, bool useEdgeNormals, F &&test)
+  {
+    constexpr int REPEAT = 20;
+
+    // same as in the scene, but the edge-planes can be turned off without rebuilding the mesh
+    std::vector<P64::Coll::Triangle> tris{};
+    for(auto &pair : pairs) {
+      tris.push_back(mesh.getTriangle(pair.tri));
+      if(!useEdgeNormals)tris.back().edgeNormals = nullptr;
+    }
+
+    Result res{};
+    res.penetration.resize(pairs.size());
+    auto t0 = Clock::now();
+    for(int i=0; i<REPEAT; ++i) {
+      for(uint32_t p=0; p<pairs.size(); ++p) {
+        res.penetration[p] = test(pairs[p], tris[p]);
+      }
+    }
+    auto t1 = Clock::now();
+
+    for(auto &pen : res.penetration)res.hits += t3d_vec3_len2(pen) > 0.0f;
+    res.nsPerTest = std::chrono::duration<double, std::nano>(t1 - t0).count() / (REPEAT * pairs.size());
+    return res;
+  }
+
+  template<typename F>
+  bool compare(const char* name, const std::vector<Pair> &pairs, const Test::CollMesh &mesh, F &&test)
+  {
+    auto resEdges = run(pairs, mesh, true, test);
+    auto resBary = run(pairs, mesh, false, test);
+
+    // edge-planes are quantized, so points right on an edge may end up on either side
+    uint32_t mismatches = 0;
+    for(uint32_t p=0; p<pairs.size(); ++p) {
+      auto diff = resEdges.penetration[p] - resBary.penetration[p];
+      if(t3d_vec3_len(diff) > 0.01f)++mismatches;
+    }
+
+    printf("%-8s %6u hits | edge-planes: %6.1f ns | barycentric: %6.1f ns (%.2fx) | %u differ\n",
+      name, resEdges.hits, resEdges.nsPerTest, resBary.nsPerTest,
+      resBary.nsPerTest / resEdges.nsPerTest, mismatches);
+
+    return mismatches <= pairs.size() / 1000;
+  }
+}
+
+P64::Scene &P64::SceneManager::getCurrent() { return gameScene; }
+
+int main()
+{
+  using namespace P64::Coll;
+  constexpr uint32_t PAIR_COUNT = 1 << 16;
+
+  auto mesh = Test::createLevelMesh(32, 500, 100.0f, 3, true);
+
+  // shapes around the triangles, about half of them touch the plane, many of those near an edge
+  std::mt19937 rng{11};
+  std::uniform_real_distribution<float> rand{-1.0f, 1.0f};
+  std::vector<Pair> pairsSphere{};
+  std::vector<Pair> pairsBox{};
+  for(uint32_t p=0; p<PAIR_COUNT; ++p) {
+    uint32_t t = rng() % mesh->mesh->triCount;
+    auto *v = &mesh->trisFloat[t*3];
+    float w0 = rand(rng) * 0.7f + 0.5f;
+    float w1 = rand(rng) * 0.7f + 0.5f;
+    auto center = v[0] + (v[1] - v[0]) * w0 * 0.5f + (v[2] - v[0]) * w1 * 0.5f;
+    center = center + fm_vec3_t{{rand(rng), rand(rng), rand(rng)}} * 3.0f;
+
+    Pair pair{.tri = t};
+    pair.bcs.center = center;
+    pair.bcs.halfExtend = {{3.0f, 3.0f, 3.0f}};
+    pair.motion = fm_vec3_t{{rand(rng), rand(rng), rand(rng)}} * 20.0f;
+    pairsSphere.push_back(pair);
+
+    pair.bcs.flags = BCSFlags::SHAPE_BOX;
+    pair.bcs.halfExtend = {{2.0f, 2.5f, 3.0f}};
+    pairsBox.push_back(pair);
+  }
+
+  auto &collMesh = *mesh->mesh;
+  bool ok = true;
+  ok &= compare("sphere", pairsSphere, *mesh, [&](const Pair &pair, const Triangle &tri) {
+    return collMesh.vsSphere(pair.bcs, tri).penetration;
+  });
+  ok &= compare("box", pairsBox, *mesh, [&](const Pair &pair, const Triangle &tri) {
+    return collMesh.vsBox(pair.bcs, tri).penetration;
+  });
+  ok &= compare("sweep", pairsSphere, *mesh, [&](const Pair &pair, const Triangle &tri) {
+    float toi = collMesh.sweep(pair.bcs, pair.motion, tri);
+    return toi <= 1.0f ? pair.motion * toi : fm_vec3_t{};
+  });
+
+  if(!ok) {
+    printf("Error: edge-planes and barycentric results differ\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "collision/scene.h"
+#include "scene/scene.h"
+#include "scene/sceneManager.h"
+#include "collMesh.h"
+
+/**
+ * Casts the same rays through 'raycast', 'raycastBatch' and 'raycastAny', against a few rotated and scaled level meshes.
+ * The reference is the query before those existed, see 'raycastReference'.
+ * Reports the time per ray of each, and checks that they agree with the reference.
+ */
+namespace
+{
+  P64::Scene gameScene{};
+  using Clock = std::chrono::steady_clock;
+  using namespace P64::Coll;
+
+  // previous node test, without the pre-calculated inverse direction and max. distance
+  bool refNodeVsRay(const AABB &aabb, const fm_vec3_t &pos, const fm_vec3_t &dir)
+  {
+    constexpr float DEF_MAX_FLOAT = 10000.0f;
+    auto invDir = fm_vec3_t{{DEF_MAX_FLOAT, DEF_MAX_FLOAT, DEF_MAX_FLOAT}};
+    if(dir.x != 0)invDir.x = 1.0f / dir.x;
+    if(dir.y != 0)invDir.y = 1.0f / dir.y;
+    if(dir.z != 0)invDir.z = 1.0f / dir.z;
+    auto vecMin = (fm_vec3_t{{(float)aabb.min.v[0], (float)aabb.min.v[1], (float)aabb.min.v[2]}} - pos) * invDir;
+    auto vecMax = (fm_vec3_t{{(float)aabb.max.v[0], (float)aabb.max.v[1], (float)aabb.max.v[2]}} - pos) * invDir;
+
+    float near = fmaxf(fmaxf(fminf(vecMin.x, vecMax.x), fminf(vecMin.y, vecMax.y)), fminf(vecMin.z, vecMax.z));
+    float far = fminf(fminf(fmaxf(vecMin.x, vecMax.x), fmaxf(vecMin.y, vecMax.y)), fmaxf(vecMin.z, vecMax.z));
+    return (far >= near ? (near < 0.0f ? far : near) : -1.0f) >= 0.0f;
+  }
+
+  /**
+   * Raycast as it was before closest-hit and any-hit queries:
+   * every mesh, and every BVH node the unbounded ray passes through, is visited.
+   * The closest of all hits is kept, so the result is the same as with 'raycast'.
+   */
+  RaycastRes raycastReference(const std::vector<MeshInstance> &instances,
+    const std::vector<std::unique_ptr<Test::CollMesh>> &meshes, const Ray &ray, float maxDist)
+  {
+    RaycastRes res{.dist = maxDist};
+    for(uint32_t m=0; m<instances.size(); ++m)
+    {
+      auto &inst = instances[m];
+      auto rayLocal = Ray::create(inst.intoLocalSpace(ray.pos), inst.invRot * ray.dir * inst.invScale);
+
+      inst.mesh->bvh->traverse(
+        [&](const AABB &aabb) { return refNodeVsRay(aabb, rayLocal.pos, rayLocal.dir); },
+        [&](uint32_t t) {
+          auto hit = inst.mesh->vsRay(rayLocal, meshes[m]->getTriangle(t));
+          if(hit.hasResult() && hit.dist < res.dist) {
+            res = hit;
+            res.hitPos = inst.outOfLocalSpace(hit.hitPos);
+            res.normal = inst.object->rot * hit.normal;
+          }
+        }
+      );
+    }
+    return res;
+  }
+
+  uint32_t countMismatches(const std::vector<RaycastRes> &res, const std::vector<RaycastRes> &ref)
+  {
+    uint32_t mismatches = 0;
+    for(uint32_t r=0; r<ref.size(); ++r) {
+      // the batch uses a matrix instead of the quaternion, so allow for rounding
+      bool sameHit = res[r].hasResult() == ref[r].hasResult();
+      if(!sameHit || (ref[r].hasResult() && fabsf(res[r].dist - ref[r].dist) > 0.01f))++mismatches;
+    }
+    return mismatches;
+  }
+}
+
+P64::Scene &P64::SceneManager::getCurrent() { return gameScene; }
+
+int main()
+{
+  constexpr uint32_t MESH_COUNT = 4;
+  constexpr uint32_t RAY_COUNT = 4096;
+  constexpr int REPEAT = 10;
+
+  std::vector<std::unique_ptr<Test::CollMesh>> meshes{};
+  std::vector<P64::Object> objects(MESH_COUNT);
+  std::vector<MeshInstance> instances(MESH_COUNT);
+  Scene scene{};
+
+  for(uint32_t m=0; m<MESH_COUNT; ++m)
+  {
+    meshes.push_back(Test::createLevelMesh(24, 300, 100.0f, m + 1));
+    auto &obj = objects[m];
+    obj.pos = {{(float)m * 150.0f - 200.0f, (float)m * 10.0f, 0.0f}};
+    obj.scale = {{1.0f + m * 0.25f, 1.0f, 1.0f + m * 0.1f}};
+    fm_vec3_t axis{{0.0f, 1.0f, 0.0f}};
+    fm_quat_from_axis_angle(&obj.rot, &axis, m * 0.4f);
+
+    instances[m].mesh = meshes.back()->mesh;
+    instances[m].object = &obj;
+    scene.registerMesh(&instances[m]);
+  }
+
+  std::mt19937 rng{7};
+  std::uniform_real_distribution<float> rand{-1.0f, 1.0f};
+  std::vector<Ray> rays{};
+  std::vector<float> maxDist{};
+  for(uint32_t r=0; r<RAY_COUNT; ++r) {
+    // mostly downwards, e.g. ground checks and projectiles
+    fm_vec3_t pos{{rand(rng) * 350.0f, 80.0f + rand(rng) * 20.0f, rand(rng) * 120.0f}};
+    fm_vec3_t dir{{rand(rng) * 0.5f, -1.0f, rand(rng) * 0.5f}};
+    fm_vec3_norm(&dir, &dir);
+    rays.push_back(Ray::create(pos, dir));
+    maxDist.push_back(r % 4 == 0 ? INFINITY : 150.0f);
+  }
+
+  std::vector<RaycastRes> resRef(RAY_COUNT);
+  std::vector<RaycastRes> resSingle(RAY_COUNT);
+  std::vector<RaycastRes> resBatch(RAY_COUNT);
+  std::vector<RaycastRes> resAny(RAY_COUNT);
+
+  auto t0 = Clock::now();
+  for(int i=0; i<REPEAT; ++i) {
+    for(uint32_t r=0; r<RAY_COUNT; ++r) {
+      resRef[r] = raycastReference(instances, meshes, rays[r], maxDist[r]);
+    }
+  }
+  auto t1 = Clock::now();
+  for(int i=0; i<REPEAT; ++i) {
+    for(uint32_t r=0; r<RAY_COUNT; ++r) {
+      resSingle[r] = scene.raycast(rays[r].pos, rays[r].dir, maxDist[r]);
+    }
+  }
+  auto t2 = Clock::now();
+  for(int i=0; i<REPEAT; ++i) {
+    scene.raycastBatch(rays.data(), maxDist.data(), resBatch.data(), RAY_COUNT);
+  }
+  auto t3 = Clock::now();
+  for(int i=0; i<REPEAT; ++i) {
+    for(uint32_t r=0; r<RAY_COUNT; ++r) {
+      // only reports if there is a hit, so the distance can't be compared
+      resAny[r] = {.flags = scene.raycastAny(rays[r].pos, rays[r].dir, maxDist[r]), .dist = resRef[r].dist};
+    }
+  }
+  auto t4 = Clock::now();
+
+  uint32_t hits = 0;
+  for(auto &res : resRef)hits += res.hasResult();
+
+  auto nsPerRay = [&](auto start, auto end) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / (REPEAT * RAY_COUNT);
+  };
+  double nsRef = nsPerRay(t0, t1);
+  uint32_t mismatches = 0;
+
+  printf("%u rays, %u meshes, %u hits\n", RAY_COUNT, MESH_COUNT, hits);
+  printf("%-13s %8.1f ns/ray\n", "reference:", nsRef);
+  for(auto &[name, ns, res] : {
+    std::tuple{"raycast:", nsPerRay(t1, t2), &resSingle},
+    std::tuple{"raycastBatch:", nsPerRay(t2, t3), &resBatch},
+    std::tuple{"raycastAny:", nsPerRay(t3, t4), &resAny},
+  }) {
+    uint32_t resMismatches = countMismatches(*res, resRef);
+    mismatches += resMismatches;
+    printf("%-13s %8.1f ns/ray (%.2fx), %u/%u agree\n", name, ns, nsRef / ns, RAY_COUNT - resMismatches, RAY_COUNT);
+  }
+
+  if(mismatches) {
+    printf("Error: %u rays got different results than the reference\n", mismatches);
+    return 1;
+  }
+  return 0;
+}
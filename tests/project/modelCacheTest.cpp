@@ -0,0 +1,100 @@
+/**
+* @copyright 2026 - Max Bebök
+* @license MIT
+*/
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "../../src/project/assets/modelCache.h"
+
+/**
+ * Writes glTF files with external buffers and images, and checks that a cached model
+ * is only used as long as none of the files it references changed.
+ */
+namespace fs = std::filesystem;
+
+namespace
+{
+  using namespace Project::Assets;
+
+  void writeFile(const fs::path &path, const std::string &data)
+  {
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    file.write(data.data(), (std::streamsize)data.size());
+  }
+
+  // .glb with only a JSON chunk, the binary chunk is optional
+  std::string createGLB(std::string json)
+  {
+    while(json.size() % 4 != 0)json += ' ';
+    auto u32 = [](uint32_t v) { std::string res(4, '\0'); memcpy(res.data(), &v, 4); return res; };
+    return "glTF" + u32(2) + u32(12 + 8 + json.size()) + u32(json.size()) + "JSON" + json;
+  }
+
+  bool check(const std::string &name, bool ok)
+  {
+    printf("[%s] %s\n", name.c_str(), ok ? "OK" : "FAILED");
+    return ok;
+  }
+
+  bool checkModel(const std::string &name, const fs::path &dir, const fs::path &modelPath)
+  {
+    GLTF::Config conf{};
+    auto cachePath = dir / "model.cache";
+    T3DM::T3DMData data{};
+
+    auto key = ModelCache::getKey(modelPath.string(), conf);
+    ModelCache::save(cachePath, key, data);
+
+    bool ok = check(name + ": unchanged files hit", key != 0
+      && ModelCache::getKey(modelPath.string(), conf) == key
+      && ModelCache::load(cachePath, key, data));
+
+    // only touch the files next to the model, the model itself stays the same
+    writeFile(dir / "mesh data.bin", std::string(64, '\x02'));
+    auto keyBin = ModelCache::getKey(modelPath.string(), conf);
+    ok &= check(name + ": changed buffer misses", keyBin != key && !ModelCache::load(cachePath, keyBin, data));
+
+    writeFile(dir / "tex.png", "new-texture");
+    auto keyTex = ModelCache::getKey(modelPath.string(), conf);
+    ok &= check(name + ": changed image misses", keyTex != keyBin && !ModelCache::load(cachePath, keyTex, data));
+
+    fs::remove(dir / "tex.png");
+    auto keyMissing = ModelCache::getKey(modelPath.string(), conf);
+    ok &= check(name + ": missing image misses", keyMissing != keyTex);
+    return ok;
+  }
+}
+
+int main()
+{
+  auto dir = fs::temp_directory_path() / "p64_modelCacheTest";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  // embedded buffers are part of the file, so only the external ones matter
+  const std::string json = R"({
+    "asset": {"version": "2.0"},
+    "buffers": [
+      {"uri": "mesh%20data.bin", "byteLength": 64},
+      {"uri": "data:application/octet-stream;base64,AAAA", "byteLength": 3}
+    ],
+    "images": [{"uri": "tex.png"}, {"bufferView": 0}]
+  })";
+
+  bool ok = true;
+  for(auto &[name, file, data] : {
+    std::tuple{"gltf", "model.gltf", json},
+    std::tuple{"glb", "model.glb", createGLB(json)},
+  }) {
+    writeFile(dir / "mesh data.bin", std::string(64, '\x01'));
+    writeFile(dir / "tex.png", "texture");
+    writeFile(dir / file, data);
+    ok &= checkModel(name, dir, dir / file);
+  }
+
+  fs::remove_all(dir);
+  return ok ? 0 : 1;
+}